@@ -94,7 +94,8 @@ struct _dictobject {
 #endif
 typedef struct {
     PyObject_HEAD;
-    char _filler[24];
+    // Pyston change: the size of BoxedDict (its hash table and keys_version)
+    char _filler[32];
 } PyDictObject;
 
 // Pyston change: these are no longer static objects:
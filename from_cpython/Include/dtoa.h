@@ -10,6 +10,17 @@ PyAPI_FUNC(char *) _Py_dg_dtoa(double d, int mode, int ndigits,
                         int *decpt, int *sign, char **rve) PYSTON_NOEXCEPT;
 PyAPI_FUNC(void) _Py_dg_freedtoa(char *s) PYSTON_NOEXCEPT;
 
+// Pyston addition: fast paths in front of _Py_dg_dtoa and _Py_dg_strtod, see Python/fast_dtoa.c.
+// They return 0 if they can't handle the input, in which case the caller has to use the dtoa.c version;
+// otherwise the results are identical to what dtoa.c would have returned.
+// _Py_fast_dtoa supports modes 0 and 2 (with ndigits <= FAST_DTOA_MAX_DIGITS) and writes the digits
+// into a buffer of FAST_DTOA_BUFFER_SIZE chars instead of allocating one.
+#define FAST_DTOA_MAX_DIGITS 17
+#define FAST_DTOA_BUFFER_SIZE 20
+PyAPI_FUNC(int) _Py_fast_dtoa(double d, int mode, int ndigits, char *digits,
+                              int *decpt, int *sign, char **rve) PYSTON_NOEXCEPT;
+PyAPI_FUNC(int) _Py_fast_strtod(const char *str, char **ptr, double *result) PYSTON_NOEXCEPT;
+
 
 #ifdef __cplusplus
 }
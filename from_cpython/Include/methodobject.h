@@ -27,6 +27,10 @@ typedef PyObject *(*PyCFunction)(PyObject *, PyObject *);
 typedef PyObject *(*PyCFunctionWithKeywords)(PyObject *, PyObject *,
 					     PyObject *);
 typedef PyObject *(*PyNoArgsFunction)(PyObject *);
+// Pyston addition: the signatures of METH_FASTCALL and METH_FASTCALL|METH_KEYWORDS functions
+typedef PyObject *(*_PyCFunctionFast)(PyObject *, PyObject **, Py_ssize_t);
+typedef PyObject *(*_PyCFunctionFastWithKeywords)(PyObject *, PyObject **, Py_ssize_t,
+                                                  PyObject *);
 
 PyAPI_FUNC(PyCFunction) PyCFunction_GetFunction(PyObject *) PYSTON_NOEXCEPT;
 PyAPI_FUNC(BORROWED(PyObject *)) PyCFunction_GetSelf(PyObject *) PYSTON_NOEXCEPT;
@@ -87,6 +91,14 @@ PyAPI_FUNC(PyObject *) PyCFunction_NewEx(PyMethodDef *, PyObject *,
 #define METH_D1        0x0200
 #define METH_D2        0x0400
 #define METH_D3        (METH_D1 | METH_D2)
+/* The positional arguments are passed as a C array plus a count instead of
+   as a tuple: f(self, args, nargs).  Combined with METH_KEYWORDS the values
+   of any keyword arguments follow the positional ones in that array, and
+   their names are passed as a tuple: f(self, args, nargs, kwnames), where
+   kwnames is NULL if there are none.  Both avoid building an argument tuple
+   (and dict) per call.  Parse the arguments with _PyArg_ParseStack,
+   _PyArg_ParseStackAndKeywords or _PyArg_UnpackStack. */
+#define METH_FASTCALL  0x0800
 
 typedef struct PyMethodChain {
     PyMethodDef *methods;		/* Methods of this type */
@@ -19,6 +19,8 @@ extern "C" {
 #define PyArg_ParseSingle		_PyArg_ParseSingle_SizeT
 #define PyArg_VaParse			_PyArg_VaParse_SizeT
 #define PyArg_VaParseTupleAndKeywords	_PyArg_VaParseTupleAndKeywords_SizeT
+#define _PyArg_ParseStack		_PyArg_ParseStack_SizeT
+#define _PyArg_ParseStackAndKeywords	_PyArg_ParseStackAndKeywords_SizeT
 #define Py_BuildValue			_Py_BuildValue_SizeT
 #define Py_VaBuildValue			_Py_VaBuildValue_SizeT
 #else
@@ -35,6 +37,12 @@ PyAPI_FUNC(int) PyArg_UnpackTuple(PyObject *, const char *, Py_ssize_t, Py_ssize
 PyAPI_FUNC(PyObject *) Py_BuildValue(const char *, ...) PYSTON_NOEXCEPT;
 PyAPI_FUNC(PyObject *) _Py_BuildValue_SizeT(const char *, ...) PYSTON_NOEXCEPT;
 PyAPI_FUNC(int) _PyArg_NoKeywords(const char *funcname, PyObject *kw) PYSTON_NOEXCEPT;
+// Pyston addition: argument parsing for METH_FASTCALL functions
+PyAPI_FUNC(int) _PyArg_ParseStack(PyObject **args, Py_ssize_t nargs, const char *, ...) PYSTON_NOEXCEPT;
+PyAPI_FUNC(int) _PyArg_ParseStackAndKeywords(PyObject **args, Py_ssize_t nargs, PyObject *kwnames,
+                                             const char *, char **, ...) PYSTON_NOEXCEPT;
+PyAPI_FUNC(int) _PyArg_UnpackStack(PyObject **args, Py_ssize_t nargs, const char *name,
+                                   Py_ssize_t min, Py_ssize_t max, ...) PYSTON_NOEXCEPT;
 
 PyAPI_FUNC(int) PyArg_VaParse(PyObject *, const char *, va_list) PYSTON_NOEXCEPT;
 PyAPI_FUNC(int) PyArg_VaParseTupleAndKeywords(PyObject *, PyObject *,
@@ -24,6 +24,8 @@ returned item's reference count.
 
 typedef struct {
     PyObject_VAR_HEAD
+    // Pyston change: added ob_hash, the cached hash of the tuple (0 if unknown)
+    long ob_hash;
     PyObject *ob_item[1];
 
     /* ob_item contains space for 'ob_size' elements.
@@ -53,7 +55,9 @@ PyAPI_FUNC(void) _PyTuple_MaybeUntrack(PyObject *) PYSTON_NOEXCEPT;
 #define PyTuple_GET_ITEM(op, i) (((PyTupleObject *)(op))->ob_item[i])
 #define PyTuple_GET_SIZE(op)    Py_SIZE(op)
 /* Macro, *only* to be used to fill in brand new tuples */
-#define PyTuple_SET_ITEM(op, i, v) (((PyTupleObject *)(op))->ob_item[i] = v)
+// Pyston change: code like izip_next and dictiter_iternextitem refills its result tuple in place when nobody else
+// holds a reference to it, so this also forgets the tuple's cached hash.
+#define PyTuple_SET_ITEM(op, i, v) (((PyTupleObject *)(op))->ob_hash = 0, ((PyTupleObject *)(op))->ob_item[i] = v)
 
 PyAPI_FUNC(int) PyTuple_ClearFreeList(void) PYSTON_NOEXCEPT;
 
@@ -183,3 +183,9 @@ class ABCMeta(type):
         # No dice; update negative cache
         cls._abc_negative_cache.add(subclass)
         return False
+
+# Pyston change: the answers of ABCMeta's __instancecheck__ and __subclasscheck__ only change
+# when the classes involved change or when something gets registered (which modifies ABCMeta),
+# so let isinstance() and issubclass() cache them.
+import __pyston__
+__pyston__.setTypecheckCacheable(ABCMeta)
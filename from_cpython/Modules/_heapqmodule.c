@@ -149,11 +149,11 @@ _siftup(PyListObject *heap, Py_ssize_t pos)
 }
 
 static PyObject *
-heappush(PyObject *self, PyObject *args)
+heappush(PyObject *self, PyObject **args, Py_ssize_t nargs)
 {
     PyObject *heap, *item;
 
-    if (!PyArg_UnpackTuple(args, "heappush", 2, 2, &heap, &item))
+    if (!_PyArg_UnpackStack(args, nargs, "heappush", 2, 2, &heap, &item))
         return NULL;
 
     if (!PyList_Check(heap)) {
@@ -211,11 +211,11 @@ PyDoc_STRVAR(heappop_doc,
 "Pop the smallest item off the heap, maintaining the heap invariant.");
 
 static PyObject *
-heapreplace(PyObject *self, PyObject *args)
+heapreplace(PyObject *self, PyObject **args, Py_ssize_t nargs)
 {
     PyObject *heap, *item, *returnitem;
 
-    if (!PyArg_UnpackTuple(args, "heapreplace", 2, 2, &heap, &item))
+    if (!_PyArg_UnpackStack(args, nargs, "heapreplace", 2, 2, &heap, &item))
         return NULL;
 
     if (!PyList_Check(heap)) {
@@ -249,12 +249,12 @@ this routine unless written as part of a conditional replacement:\n\n\
         item = heapreplace(heap, item)\n");
 
 static PyObject *
-heappushpop(PyObject *self, PyObject *args)
+heappushpop(PyObject *self, PyObject **args, Py_ssize_t nargs)
 {
     PyObject *heap, *item, *returnitem;
     int cmp;
 
-    if (!PyArg_UnpackTuple(args, "heappushpop", 2, 2, &heap, &item))
+    if (!_PyArg_UnpackStack(args, nargs, "heappushpop", 2, 2, &heap, &item))
         return NULL;
 
     if (!PyList_Check(heap)) {
@@ -571,15 +571,16 @@ PyDoc_STRVAR(nsmallest_doc,
 \n\
 Equivalent to:  sorted(iterable)[:n]\n");
 
+/* Pyston change: heappush, heappushpop and heapreplace are METH_FASTCALL */
 static PyMethodDef heapq_methods[] = {
     {"heappush",        (PyCFunction)heappush,
-        METH_VARARGS,           heappush_doc},
+        METH_FASTCALL,          heappush_doc},
     {"heappushpop",     (PyCFunction)heappushpop,
-        METH_VARARGS,           heappushpop_doc},
+        METH_FASTCALL,          heappushpop_doc},
     {"heappop",         (PyCFunction)heappop,
         METH_O,                 heappop_doc},
     {"heapreplace",     (PyCFunction)heapreplace,
-        METH_VARARGS,           heapreplace_doc},
+        METH_FASTCALL,          heapreplace_doc},
     {"heapify",         (PyCFunction)heapify,
         METH_O,                 heapify_doc},
     {"nlargest",        (PyCFunction)nlargest,
@@ -536,6 +536,23 @@ itemgetter_call(itemgetterobject *ig, PyObject *args, PyObject *kw)
     return result;
 }
 
+/* Pyston addition: if f is an itemgetter of a single non-negative int
+   (which is what namedtuple uses for its field properties), stores the int
+   in *index and returns 1; otherwise returns 0.  Lets the getattr IC turn
+   such field accesses into a direct load from the tuple. */
+PyAPI_FUNC(int)
+_PyOperator_GetItemgetterIndex(PyObject *f, Py_ssize_t *index)
+{
+    itemgetterobject *ig = (itemgetterobject *)f;
+
+    if (Py_TYPE(f) != &itemgetter_type || ig->nitems != 1 || !PyInt_CheckExact(ig->item))
+        return 0;
+    if (PyInt_AS_LONG(ig->item) < 0)
+        return 0;
+    *index = PyInt_AS_LONG(ig->item);
+    return 1;
+}
+
 PyDoc_STRVAR(itemgetter_doc,
 "itemgetter(item, ...) --> itemgetter object\n\
 \n\
@@ -0,0 +1,132 @@
+/* stringlib: vectorized codec kernels */
+
+#ifndef STRINGLIB_CODECS_SIMD_H
+#define STRINGLIB_CODECS_SIMD_H
+
+/* Pyston addition: SSE2 versions of the per-character loops of the ASCII,
+   Latin-1 and UTF-8 codecs.  Most text that goes through these codecs is
+   ASCII, or ASCII with the occasional multibyte character, so the kernels
+   handle runs of characters below a limit 16 at a time and leave everything
+   else, including all error handling, to the scalar code in
+   unicodeobject.c.  As for fastsearch_simd.h, SSE2 is part of the x86-64
+   baseline and doesn't need any runtime CPU detection.
+
+   Without SSE2 (or with 2-byte Py_UNICODE) the same functions are provided
+   as plain loops, so callers don't need to care. */
+
+#if defined(__SSE2__) && Py_UNICODE_SIZE == 4
+#include <emmintrin.h>
+#define STRINGLIB_HAVE_CODECS_SIMD 1
+#endif
+
+/* Returns the length of the longest ASCII-only prefix of s[0:n]. */
+Py_LOCAL_INLINE(Py_ssize_t)
+codecs_ascii_prefix(const char *s, Py_ssize_t n)
+{
+    Py_ssize_t i = 0;
+
+#ifdef STRINGLIB_HAVE_CODECS_SIMD
+    for (; i + 32 <= n; i += 32) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(s + i + 16));
+        if (_mm_movemask_epi8(_mm_or_si128(a, b)))
+            break;
+    }
+    for (; i + 16 <= n; i += 16) {
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(s + i)));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    while (i < n && !(s[i] & 0x80))
+        i++;
+    return i;
+}
+
+#ifdef STRINGLIB_HAVE_CODECS_SIMD
+/* Zero-extends the 16 bytes of chunk to 4-byte characters at out[0:16]. */
+Py_LOCAL_INLINE(void)
+codecs_widen16(__m128i chunk, Py_UNICODE *out)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_unpacklo_epi8(chunk, zero);
+    __m128i hi = _mm_unpackhi_epi8(chunk, zero);
+
+    _mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128((__m128i *)(out + 4), _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128((__m128i *)(out + 8), _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128((__m128i *)(out + 12), _mm_unpackhi_epi16(hi, zero));
+}
+#endif
+
+/* Latin-1 decoding: widens all of s[0:n] into out[0:n]. */
+Py_LOCAL_INLINE(void)
+codecs_widen_ucs1(const char *s, Py_ssize_t n, Py_UNICODE *out)
+{
+    Py_ssize_t i = 0;
+
+#ifdef STRINGLIB_HAVE_CODECS_SIMD
+    for (; i + 16 <= n; i += 16)
+        codecs_widen16(_mm_loadu_si128((const __m128i *)(s + i)), out + i);
+#endif
+    for (; i < n; i++)
+        out[i] = (unsigned char)s[i];
+}
+
+/* ASCII decoding: widens the longest ASCII-only prefix of s[0:n] into out
+   and returns its length.  out must have room for n characters, since
+   whole blocks of 16 are written even if only part of them is ASCII. */
+Py_LOCAL_INLINE(Py_ssize_t)
+codecs_decode_ascii_run(const char *s, Py_ssize_t n, Py_UNICODE *out)
+{
+    Py_ssize_t i = 0;
+
+#ifdef STRINGLIB_HAVE_CODECS_SIMD
+    for (; i + 16 <= n; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(s + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(chunk);
+        codecs_widen16(chunk, out + i);
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    for (; i < n && !(s[i] & 0x80); i++)
+        out[i] = (unsigned char)s[i];
+    return i;
+}
+
+/* ASCII and Latin-1 encoding: narrows the longest prefix of p[0:n] whose
+   characters are all below limit (128 or 256) into out and returns its
+   length.  Nothing past that prefix is written. */
+Py_LOCAL_INLINE(Py_ssize_t)
+codecs_encode_ucs1_run(const Py_UNICODE *p, Py_ssize_t n, char *out, Py_UNICODE limit)
+{
+    Py_ssize_t i = 0;
+
+    assert(limit == 128 || limit == 256);
+#ifdef STRINGLIB_HAVE_CODECS_SIMD
+    {
+        const __m128i high_bits = _mm_set1_epi32(~(int)(limit - 1));
+        const __m128i zero = _mm_setzero_si128();
+
+        for (; i + 16 <= n; i += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i *)(p + i));
+            __m128i b = _mm_loadu_si128((const __m128i *)(p + i + 4));
+            __m128i c = _mm_loadu_si128((const __m128i *)(p + i + 8));
+            __m128i d = _mm_loadu_si128((const __m128i *)(p + i + 12));
+            __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, high_bits), zero)) != 0xffff)
+                break;
+            /* All 16 characters are below 256, so neither pack saturates. */
+            _mm_storeu_si128((__m128i *)(out + i),
+                             _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+        }
+    }
+#endif
+    for (; i < n && p[i] < limit; i++)
+        out[i] = (char)p[i];
+    return i;
+}
+
+#endif /* !STRINGLIB_CODECS_SIMD_H */
@@ -33,6 +33,9 @@
 #define STRINGLIB_BLOOM(mask, ch)     \
     ((mask &  (1UL << ((ch) & (STRINGLIB_BLOOM_WIDTH -1)))))
 
+// Pyston change: vectorized kernels for the common cases
+#include "fastsearch_simd.h"
+
 Py_LOCAL_INLINE(Py_ssize_t)
 fastsearch(const STRINGLIB_CHAR* s, Py_ssize_t n,
            const STRINGLIB_CHAR* p, Py_ssize_t m,
@@ -47,6 +50,19 @@ fastsearch(const STRINGLIB_CHAR* s, Py_ssize_t n,
     if (w < 0 || (mode == FAST_COUNT && maxcount == 0))
         return -1;
 
+    // Pyston change: use the vectorized kernels where they apply.  The
+    // sizeof() checks are compile-time constants, so each instantiation of
+    // this function only keeps the branch for its own character size.
+#ifdef STRINGLIB_HAVE_SIMD
+    if (sizeof(STRINGLIB_CHAR) == 1 && m > 0
+        && (m == 1 || (m <= SIMD_SEARCH_MAX_NEEDLE && mode != FAST_RSEARCH)))
+        return simd_fastsearch1((const char *)s, n, (const char *)p, m,
+                                maxcount, mode);
+    if (sizeof(STRINGLIB_CHAR) == 4 && m == 1)
+        return simd_fastsearch4((const Py_UCS4 *)s, n, *(const Py_UCS4 *)p,
+                                maxcount, mode);
+#endif
+
     /* look for special cases */
     if (m <= 1) {
         if (m <= 0)
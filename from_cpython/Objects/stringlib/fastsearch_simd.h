@@ -0,0 +1,208 @@
+/* stringlib: vectorized search kernels */
+
+#ifndef STRINGLIB_FASTSEARCH_SIMD_H
+#define STRINGLIB_FASTSEARCH_SIMD_H
+
+/* Pyston addition: SSE2 versions of the hot loops of fastsearch() and of
+   the whitespace split.  SSE2 is part of the x86-64 baseline, so these
+   don't need any runtime CPU detection; single-character find/rfind on
+   1-byte strings go through memchr/memrchr, which glibc already resolves
+   to the best implementation for the running CPU (AVX2 where available).
+
+   The 1-byte kernels are used for str and bytearray, the 4-byte ones for
+   unicode (Py_UNICODE_SIZE == 4).  Like fastsearch() itself, callers pass
+   FAST_COUNT / FAST_SEARCH / FAST_RSEARCH as the mode. */
+
+#if defined(__SSE2__)
+
+#include <emmintrin.h>
+
+#define STRINGLIB_HAVE_SIMD 1
+
+/* Longer needles are better served by the skip table in fastsearch(). */
+#define SIMD_SEARCH_MAX_NEEDLE 32
+
+/* Number of occurrences of ch in s[0:n]. */
+Py_LOCAL_INLINE(Py_ssize_t)
+simd_count_char(const char *s, Py_ssize_t n, char ch)
+{
+    const __m128i needle = _mm_set1_epi8(ch);
+    const __m128i zero = _mm_setzero_si128();
+    Py_ssize_t count = 0;
+    Py_ssize_t i = 0;
+
+    while (n - i >= 16) {
+        /* Each byte lane of acc counts the matches seen in that lane, so
+           fold it into count before any lane can wrap around. */
+        __m128i acc = zero;
+        Py_ssize_t blocks = (n - i) / 16;
+        Py_ssize_t b;
+
+        if (blocks > 255)
+            blocks = 255;
+        for (b = 0; b < blocks; b++, i += 16) {
+            __m128i chunk = _mm_loadu_si128((const __m128i *)(s + i));
+            acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(chunk, needle));
+        }
+        acc = _mm_sad_epu8(acc, zero);
+        count += _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(acc, acc));
+    }
+    for (; i < n; i++)
+        count += (s[i] == ch);
+    return count;
+}
+
+/* Search for p[0:m] in s[0:n], 2 <= m <= n, in FAST_SEARCH or FAST_COUNT
+   mode.  Candidate positions are found 16 at a time by comparing the first
+   and the last character of the pattern, and only those get checked with
+   memcmp. */
+Py_LOCAL_INLINE(Py_ssize_t)
+simd_search(const char *s, Py_ssize_t n, const char *p, Py_ssize_t m,
+            Py_ssize_t maxcount, int mode)
+{
+    const __m128i first = _mm_set1_epi8(p[0]);
+    const __m128i last = _mm_set1_epi8(p[m - 1]);
+    Py_ssize_t count = 0;
+    Py_ssize_t next = 0;        /* counted matches can't overlap */
+    Py_ssize_t base;
+
+    assert(m >= 2 && m <= n && mode != FAST_RSEARCH);
+
+    for (base = 0; base + m - 1 + 16 <= n; base += 16) {
+        __m128i block_first = _mm_loadu_si128((const __m128i *)(s + base));
+        __m128i block_last = _mm_loadu_si128((const __m128i *)(s + base + m - 1));
+        unsigned int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first),
+                                                            _mm_cmpeq_epi8(block_last, last)));
+        while (mask) {
+            Py_ssize_t pos = base + __builtin_ctz(mask);
+            mask &= mask - 1;
+            if (pos < next)
+                continue;
+            if (memcmp(s + pos + 1, p + 1, m - 2) == 0) {
+                if (mode != FAST_COUNT)
+                    return pos;
+                count++;
+                if (count == maxcount)
+                    return maxcount;
+                next = pos + m;
+            }
+        }
+    }
+
+    /* Positions in [base, n - m] haven't been looked at yet. */
+    if (next < base)
+        next = base;
+    for (; next + m <= n; next++) {
+        if (s[next] == p[0] && memcmp(s + next + 1, p + 1, m - 1) == 0) {
+            if (mode != FAST_COUNT)
+                return next;
+            count++;
+            if (count == maxcount)
+                return maxcount;
+            next += m - 1;
+        }
+    }
+
+    return mode == FAST_COUNT ? count : -1;
+}
+
+/* fastsearch() for 1-byte characters, when the pattern is short. */
+Py_LOCAL_INLINE(Py_ssize_t)
+simd_fastsearch1(const char *s, Py_ssize_t n, const char *p, Py_ssize_t m,
+                 Py_ssize_t maxcount, int mode)
+{
+    const char *found;
+
+    if (m > 1)
+        return simd_search(s, n, p, m, maxcount, mode);
+
+    if (mode == FAST_COUNT) {
+        Py_ssize_t count = simd_count_char(s, n, p[0]);
+        return count < maxcount ? count : maxcount;
+    }
+
+    if (mode == FAST_SEARCH)
+        found = (const char *)memchr(s, p[0], n);
+    else
+        found = (const char *)memrchr(s, p[0], n);
+    return found ? found - s : -1;
+}
+
+/* fastsearch() for 4-byte characters, when the pattern is one character. */
+Py_LOCAL_INLINE(Py_ssize_t)
+simd_fastsearch4(const Py_UCS4 *s, Py_ssize_t n, Py_UCS4 ch,
+                 Py_ssize_t maxcount, int mode)
+{
+    const __m128i needle = _mm_set1_epi32((int)ch);
+    Py_ssize_t count = 0;
+    Py_ssize_t i;
+    int mask;
+
+    if (mode == FAST_RSEARCH) {
+        for (i = n; i >= 4; i -= 4) {
+            __m128i chunk = _mm_loadu_si128((const __m128i *)(s + i - 4));
+            mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(chunk, needle)));
+            if (mask)
+                return i - 4 + (31 - __builtin_clz(mask));
+        }
+        while (i-- > 0) {
+            if (s[i] == ch)
+                return i;
+        }
+        return -1;
+    }
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(s + i));
+        mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(chunk, needle)));
+        if (mode == FAST_SEARCH) {
+            if (mask)
+                return i + __builtin_ctz(mask);
+        } else {
+            count += __builtin_popcount(mask);
+        }
+    }
+    for (; i < n; i++) {
+        if (s[i] == ch) {
+            if (mode == FAST_SEARCH)
+                return i;
+            count++;
+        }
+    }
+
+    if (mode == FAST_SEARCH)
+        return -1;
+    return count < maxcount ? count : maxcount;
+}
+
+/* Returns the index of the first character in s[i:n] that is whitespace
+   (if want_space) or not whitespace (otherwise), or n if there is none.
+   Whitespace is what Py_ISSPACE accepts: ' ' and '\t' through '\r'. */
+Py_LOCAL_INLINE(Py_ssize_t)
+simd_find_space(const char *s, Py_ssize_t i, Py_ssize_t n, int want_space)
+{
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i ctrl_range = _mm_set1_epi8('\r' - '\t');
+    const unsigned int flip = want_space ? 0 : 0xffff;
+
+    for (; i + 16 <= n; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i ctrl = _mm_sub_epi8(chunk, tab);
+        /* unsigned (c - '\t') <= ('\r' - '\t') */
+        __m128i is_ctrl = _mm_cmpeq_epi8(_mm_min_epu8(ctrl, ctrl_range), ctrl);
+        __m128i is_space = _mm_or_si128(_mm_cmpeq_epi8(chunk, space), is_ctrl);
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(is_space) ^ flip;
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    for (; i < n; i++) {
+        if ((Py_ISSPACE(s[i]) != 0) == want_space)
+            return i;
+    }
+    return n;
+}
+
+#endif /* __SSE2__ */
+
+#endif /* !STRINGLIB_FASTSEARCH_SIMD_H */
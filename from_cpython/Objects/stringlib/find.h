@@ -104,10 +104,12 @@ is ok.
 
 #define FORMAT_BUFFER_SIZE 50
 
+/* Pyston change: the parsing is done on an array of arguments, so that
+   METH_FASTCALL methods can use it directly. */
 Py_LOCAL_INLINE(int)
-stringlib_parse_args_finds(const char * function_name, PyObject *args,
-                           PyObject **subobj,
-                           Py_ssize_t *start, Py_ssize_t *end)
+stringlib_parse_stack_finds(const char * function_name, PyObject **args,
+                            Py_ssize_t nargs, PyObject **subobj,
+                            Py_ssize_t *start, Py_ssize_t *end)
 {
     PyObject *tmp_subobj;
     Py_ssize_t tmp_start = 0;
@@ -119,7 +121,7 @@ stringlib_parse_args_finds(const char * function_name, PyObject *args,
     strncpy(format + len, function_name, FORMAT_BUFFER_SIZE - len - 1);
     format[FORMAT_BUFFER_SIZE - 1] = '\0';
 
-    if (!PyArg_ParseTuple(args, format, &tmp_subobj, &obj_start, &obj_end))
+    if (!_PyArg_ParseStack(args, nargs, format, &tmp_subobj, &obj_start, &obj_end))
         return 0;
 
     /* To support None in "start" and "end" arguments, meaning
@@ -138,6 +140,16 @@ stringlib_parse_args_finds(const char * function_name, PyObject *args,
     return 1;
 }
 
+Py_LOCAL_INLINE(int)
+stringlib_parse_args_finds(const char * function_name, PyObject *args,
+                           PyObject **subobj,
+                           Py_ssize_t *start, Py_ssize_t *end)
+{
+    assert(PyTuple_Check(args));
+    return stringlib_parse_stack_finds(function_name, &PyTuple_GET_ITEM(args, 0),
+                                       PyTuple_GET_SIZE(args), subobj, start, end);
+}
+
 #undef FORMAT_BUFFER_SIZE
 
 #if STRINGLIB_IS_UNICODE
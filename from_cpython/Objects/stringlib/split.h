@@ -53,6 +53,28 @@
 /* Always force the list to the expected size. */
 #define FIX_PREALLOC_SIZE(list) Py_SIZE(list) = count
 
+// Pyston change: returns the index of the first character in str[i:str_len]
+// that is whitespace (if want_space) or not whitespace (otherwise), or
+// str_len.  1-byte strings (str and bytearray, where STRINGLIB_ISSPACE is
+// Py_ISSPACE) use the vectorized scan.
+Py_LOCAL_INLINE(Py_ssize_t)
+stringlib_find_space(const STRINGLIB_CHAR* str, Py_ssize_t i, Py_ssize_t str_len,
+                     int want_space)
+{
+#ifdef STRINGLIB_HAVE_SIMD
+    if (sizeof(STRINGLIB_CHAR) == 1)
+        return simd_find_space((const char *)str, i, str_len, want_space);
+#endif
+    if (want_space) {
+        while (i < str_len && !STRINGLIB_ISSPACE(str[i]))
+            i++;
+    } else {
+        while (i < str_len && STRINGLIB_ISSPACE(str[i]))
+            i++;
+    }
+    return i;
+}
+
 Py_LOCAL_INLINE(PyObject *)
 stringlib_split_whitespace(PyObject* str_obj,
                            const STRINGLIB_CHAR* str, Py_ssize_t str_len,
@@ -67,12 +89,16 @@ stringlib_split_whitespace(PyObject* str_obj,
 
     i = j = 0;
     while (maxcount-- > 0) {
-        while (i < str_len && STRINGLIB_ISSPACE(str[i]))
-            i++;
+        // Pyston change:
+        // while (i < str_len && STRINGLIB_ISSPACE(str[i]))
+        //     i++;
+        i = stringlib_find_space(str, i, str_len, 0);
         if (i == str_len) break;
         j = i; i++;
-        while (i < str_len && !STRINGLIB_ISSPACE(str[i]))
-            i++;
+        // Pyston change:
+        // while (i < str_len && !STRINGLIB_ISSPACE(str[i]))
+        //     i++;
+        i = stringlib_find_space(str, i, str_len, 1);
 #ifndef STRINGLIB_MUTABLE
         if (j == 0 && i == str_len && STRINGLIB_CHECK_EXACT(str_obj)) {
             /* No whitespace in str_obj, so just use it as list[0] */
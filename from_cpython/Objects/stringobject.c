@@ -89,14 +89,15 @@ string_count(PyStringObject *self,
         );
 }
 
-PyObject * string_split(PyStringObject *self, PyObject *args)
+// Pyston change: split, rsplit and the find family are METH_FASTCALL
+PyObject * string_split(PyStringObject *self, PyObject **args, Py_ssize_t nargs)
 {
     Py_ssize_t len = PyString_GET_SIZE(self), n;
     Py_ssize_t maxsplit = -1;
     const char *s = PyString_AS_STRING(self), *sub;
     PyObject *subobj = Py_None;
 
-    if (!PyArg_ParseTuple(args, "|On:split", &subobj, &maxsplit))
+    if (!_PyArg_ParseStack(args, nargs, "|On:split", &subobj, &maxsplit))
         return NULL;
     if (maxsplit < 0)
         maxsplit = PY_SSIZE_T_MAX;
@@ -116,13 +117,13 @@ PyObject * string_split(PyStringObject *self, PyObject *args)
     return stringlib_split((PyObject*) self, s, len, sub, n, maxsplit);
 }
 
-PyObject* string_rsplit(PyStringObject* self, PyObject* args) {
+PyObject* string_rsplit(PyStringObject* self, PyObject** args, Py_ssize_t nargs) {
     Py_ssize_t len = PyString_GET_SIZE(self), n;
     Py_ssize_t maxsplit = -1;
     const char* s = PyString_AS_STRING(self), *sub;
     PyObject* subobj = Py_None;
 
-    if (!PyArg_ParseTuple(args, "|On:rsplit", &subobj, &maxsplit))
+    if (!_PyArg_ParseStack(args, nargs, "|On:rsplit", &subobj, &maxsplit))
         return NULL;
     if (maxsplit < 0)
         maxsplit = PY_SSIZE_T_MAX;
@@ -143,15 +144,15 @@ PyObject* string_rsplit(PyStringObject* self, PyObject* args) {
 }
 
 Py_LOCAL_INLINE(Py_ssize_t)
-string_find_internal(PyStringObject *self, PyObject *args, int dir)
+string_find_internal(PyStringObject *self, PyObject **args, Py_ssize_t nargs, int dir)
 {
     PyObject *subobj;
     const char *sub;
     Py_ssize_t sub_len;
     Py_ssize_t start=0, end=PY_SSIZE_T_MAX;
 
-    if (!stringlib_parse_args_finds("find/rfind/index/rindex",
-                                    args, &subobj, &start, &end))
+    if (!stringlib_parse_stack_finds("find/rfind/index/rindex",
+                                     args, nargs, &subobj, &start, &end))
         return -2;
 
     if (PyString_Check(subobj)) {
@@ -179,27 +180,27 @@ string_find_internal(PyStringObject *self, PyObject *args, int dir)
 }
 
 PyObject *
-string_rfind(PyStringObject *self, PyObject *args)
+string_rfind(PyStringObject *self, PyObject **args, Py_ssize_t nargs)
 {
-    Py_ssize_t result = string_find_internal(self, args, -1);
+    Py_ssize_t result = string_find_internal(self, args, nargs, -1);
     if (result == -2)
         return NULL;
     return PyInt_FromSsize_t(result);
 }
 
 PyObject *
-string_find(PyStringObject *self, PyObject *args)
+string_find(PyStringObject *self, PyObject **args, Py_ssize_t nargs)
 {
-    Py_ssize_t result = string_find_internal(self, args, +1);
+    Py_ssize_t result = string_find_internal(self, args, nargs, +1);
     if (result == -2)
         return NULL;
     return PyInt_FromSsize_t(result);
 }
 
 PyObject *
-string_index(PyStringObject *self, PyObject *args)
+string_index(PyStringObject *self, PyObject **args, Py_ssize_t nargs)
 {
-    Py_ssize_t result = string_find_internal(self, args, +1);
+    Py_ssize_t result = string_find_internal(self, args, nargs, +1);
     if (result == -2)
         return NULL;
     if (result == -1) {
@@ -211,9 +212,9 @@ string_index(PyStringObject *self, PyObject *args)
 }
 
 PyObject *
-string_rindex(PyStringObject *self, PyObject *args)
+string_rindex(PyStringObject *self, PyObject **args, Py_ssize_t nargs)
 {
-    Py_ssize_t result = string_find_internal(self, args, -1);
+    Py_ssize_t result = string_find_internal(self, args, nargs, -1);
     if (result == -2)
         return NULL;
     if (result == -1) {
@@ -46,6 +46,8 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include "unicodeobject.h"
 #include "ucnhash.h"
+// Pyston change: vectorized codec loops
+#include "stringlib/codecs_simd.h"
 
 #ifdef MS_WINDOWS
 #include <windows.h>
@@ -130,6 +132,23 @@ static PyUnicodeObject *unicode_latin1[256] = {NULL};
 */
 static char unicode_default_encoding[100 + 1] = "ascii";
 
+/* Pyston addition: shortcuts for ASCII-only text.
+
+   While the default encoding is ASCII, defenc (which str(u) fills in) can only
+   ever be set on ASCII-only unicode objects, and then holds exactly their
+   ASCII encoding, which is also their Latin-1 and UTF-8 encoding.  So
+   unicode.encode with one of these codecs can just return it.  In the other
+   direction, decoding ASCII-only text with one of them is a plain widening
+   of the characters, without going through the codec.
+
+   Nothing new gets attached to unicode objects here: the memory use is the
+   same as without the shortcuts.
+
+   This is cleared for good once the default encoding gets changed, since
+   defenc values that were computed with another encoding might then stay
+   around. */
+static int defenc_is_ascii = 1;
+
 /* Fast detection of the most frequent whitespace characters */
 const unsigned char _Py_ascii_whitespace[] = {
     0, 0, 0, 0, 0, 0, 0, 0,
@@ -1145,6 +1164,55 @@ PyObject *PyUnicode_FromOrdinal(int ordinal)
     return PyUnicode_FromUnicode(s, 1);
 }
 
+/* Pyston addition: helpers for the 1-byte form of ASCII-only unicode objects
+   (see defenc_is_ascii). */
+
+/* Whether the codec is one for which ASCII-only text and its 1-byte form are
+   the same thing.  NULL stands for the default encoding. */
+static int
+is_ascii_superset_encoding(const char *encoding)
+{
+    if (encoding == NULL)
+        return 1;
+    return strcmp(encoding, "utf-8") == 0 || strcmp(encoding, "UTF-8") == 0 ||
+           strcmp(encoding, "latin-1") == 0 || strcmp(encoding, "ascii") == 0;
+}
+
+static int
+is_ascii_only(const char *s, Py_ssize_t size)
+{
+    return codecs_ascii_prefix(s, size) == size;
+}
+
+/* Returns a new reference to the 1-byte form of unicode if it is known, or
+   NULL (without an exception set).  The result is shared with unicode, so
+   this is only for results that go back to Python code: C callers of the
+   PyUnicode_As*String functions may assume they own the result exclusively
+   and resize it or write into it. */
+static PyObject *
+unicode_get_ascii_form(PyObject *unicode)
+{
+    PyObject *v = ((PyUnicodeObject *)unicode)->defenc;
+
+    if (!defenc_is_ascii || v == NULL || !PyString_CheckExact(v))
+        return NULL;
+    Py_INCREF(v);
+    return v;
+}
+
+/* Decodes str, which has to be ASCII-only, by widening its characters. */
+static PyObject *
+unicode_decode_ascii_form(PyObject *str)
+{
+    PyUnicodeObject *v;
+
+    v = _PyUnicode_New(PyString_GET_SIZE(str));
+    if (v == NULL)
+        return NULL;
+    codecs_widen_ucs1(PyString_AS_STRING(str), PyString_GET_SIZE(str), v->str);
+    return (PyObject *)v;
+}
+
 PyObject *PyUnicode_FromObject(register PyObject *obj)
 {
     /* XXX Perhaps we should make this API an alias of
@@ -1205,6 +1273,13 @@ PyObject *PyUnicode_FromEncodedObject(register PyObject *obj,
     if (PyString_Check(obj)) {
         s = PyString_AS_STRING(obj);
         len = PyString_GET_SIZE(obj);
+
+        /* Pyston addition: skip the codec for ASCII-only text.  Empty and
+           single-character strings are left to the codecs, which return
+           shared objects. */
+        if (len > 1 && defenc_is_ascii && PyString_CheckExact(obj) &&
+            is_ascii_superset_encoding(encoding) && is_ascii_only(s, len))
+            return unicode_decode_ascii_form(obj);
     }
     else if (PyByteArray_Check(obj)) {
         /* Python 2.x specific */
@@ -1441,6 +1516,9 @@ int PyUnicode_SetDefaultEncoding(const char *encoding)
     strncpy(unicode_default_encoding,
             encoding,
             sizeof(unicode_default_encoding) - 1);
+    // Pyston addition:
+    if (strcmp(unicode_default_encoding, "ascii") != 0)
+        defenc_is_ascii = 0;
     return 0;
 
   onError:
@@ -1982,8 +2060,11 @@ PyObject *PyUnicode_DecodeUTF8Stateful(const char *s,
         Py_UCS4 ch = (unsigned char)*s;
 
         if (ch < 0x80) {
-            *p++ = (Py_UNICODE)ch;
-            s++;
+            /* Pyston change: decode the whole ASCII run at once.  The output
+               never has fewer free slots than there are input bytes left. */
+            Py_ssize_t run = codecs_decode_ascii_run(s, e - s, p);
+            s += run;
+            p += run;
             continue;
         }
 
@@ -2168,13 +2249,18 @@ PyUnicode_EncodeUTF8(const Py_UNICODE *s,
     }
 
     for (i = 0; i < size;) {
-        Py_UCS4 ch = s[i++];
+        Py_UCS4 ch;
 
-        if (ch < 0x80)
-            /* Encode ASCII */
-            *p++ = (char) ch;
+        if (s[i] < 0x80) {
+            /* Pyston change: encode the whole ASCII run at once */
+            Py_ssize_t run = codecs_encode_ucs1_run(s + i, size - i, p, 0x80);
+            i += run;
+            p += run;
+            continue;
+        }
 
-        else if (ch < 0x0800) {
+        ch = s[i++];
+        if (ch < 0x0800) {
             /* Encode Latin-1 */
             *p++ = (char)(0xc0 | (ch >> 6));
             *p++ = (char)(0x80 | (ch & 0x3f));
@@ -3482,7 +3568,6 @@ PyObject *PyUnicode_DecodeLatin1(const char *s,
                                  const char *errors)
 {
     PyUnicodeObject *v;
-    Py_UNICODE *p;
 
     /* Latin-1 is equivalent to the first 256 ordinals in Unicode. */
     if (size == 1) {
@@ -3495,9 +3580,8 @@ PyObject *PyUnicode_DecodeLatin1(const char *s,
         goto onError;
     if (size == 0)
         return (PyObject *)v;
-    p = PyUnicode_AS_UNICODE(v);
-    while (size-- > 0)
-        *p++ = (unsigned char)*s++;
+    // Pyston change: widen in bulk
+    codecs_widen_ucs1(s, size, PyUnicode_AS_UNICODE(v));
     return (PyObject *)v;
 
   onError:
@@ -3636,8 +3720,10 @@ static PyObject *unicode_encode_ucs1(const Py_UNICODE *p,
         /* can we encode this? */
         if (c<limit) {
             /* no overflow check, because we know that the space is enough */
-            *str++ = (char)c;
-            ++p;
+            // Pyston change: encode the whole run of encodable characters at once
+            Py_ssize_t run = codecs_encode_ucs1_run(p, endp - p, str, limit);
+            str += run;
+            p += run;
         }
         else {
             Py_ssize_t unicodepos = p-startp;
@@ -3817,8 +3903,10 @@ PyObject *PyUnicode_DecodeASCII(const char *s,
     while (s < e) {
         register unsigned char c = (unsigned char)*s;
         if (c < 128) {
-            *p++ = c;
-            ++s;
+            // Pyston change: decode the whole ASCII run at once
+            Py_ssize_t run = codecs_decode_ascii_run(s, e - s, p);
+            p += run;
+            s += run;
         }
         else {
             startinpos = s-starts;
@@ -6429,7 +6517,17 @@ unicode_encode(PyUnicodeObject *self, PyObject *args, PyObject *kwargs)
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|ss:encode",
                                      kwlist, &encoding, &errors))
         return NULL;
-    v = PyUnicode_AsEncodedObject((PyObject *)self, encoding, errors);
+    /* Pyston change: for the common codecs, return the 1-byte form of
+       ASCII-only text if we have it, and otherwise use the shortcuts of
+       PyUnicode_AsEncodedString rather than going through the codec
+       registry. */
+    if (errors == NULL && encoding != NULL && is_ascii_superset_encoding(encoding)) {
+        v = unicode_get_ascii_form((PyObject *)self);
+        if (v == NULL)
+            v = PyUnicode_AsEncodedString((PyObject *)self, encoding, errors);
+    }
+    else
+        v = PyUnicode_AsEncodedObject((PyObject *)self, encoding, errors);
     if (v == NULL)
         goto onError;
     if (!PyString_Check(v) && !PyUnicode_Check(v)) {
@@ -0,0 +1,568 @@
+// This file is not from CPython; it is a Pyston addition that sits in front of dtoa.c.
+
+/* Fast paths for float <-> string conversions.
+
+   _Py_dg_dtoa() and _Py_dg_strtod() from dtoa.c are exact for every input, but they do all
+   of their work with bignums, which makes repr(float) and float(str) expensive.  This file
+   implements the usual fast algorithms in front of them:
+
+   - _Py_fast_dtoa() generates the shortest round-tripping digits (dtoa mode 0, used by
+     repr()) or a fixed number of correctly rounded digits (dtoa mode 2, used by str() and
+     %g / %e) with Grisu3 (Florian Loitsch, "Printing Floating-Point Numbers Quickly and
+     Accurately with Integers", PLDI 2010).  Grisu3 knows when it can't prove that its
+     result is the one dtoa would produce, which happens for roughly 0.5% of doubles; it
+     then fails and the caller falls back to _Py_dg_dtoa().
+
+   - _Py_fast_strtod() parses decimal strings with at most 19 significant digits, using
+     Clinger's fast path when the significand and the power of ten are both exact doubles
+     and the Eisel-Lemire algorithm otherwise (Daniel Lemire, "Number Parsing at a
+     Gigabyte per Second", 2021; this follows the formulation from Nigel Tao's
+     description of it).  Anything else -- more digits, subnormal or overflowing results,
+     and the rare inputs that land too close to a rounding boundary -- is left to
+     _Py_dg_strtod().
+
+   When they succeed, both functions produce exactly what dtoa.c would have produced, so
+   the formatting code in pystrtod.c doesn't change behavior.
+
+   The power-of-ten tables are generated by tools/gen_fast_dtoa_tables.py. */
+
+#include "Python.h"
+
+#ifndef PY_NO_SHORT_FLOAT_REPR
+
+#include <stdint.h>
+#include <string.h>
+
+#include "fast_dtoa_tables.h"
+
+/* A floating-point number f * 2**e with a 64-bit significand (a "DiyFp"). */
+typedef struct {
+    uint64_t f;
+    int e;
+} diy_fp;
+
+#define DOUBLE_SIGNIFICAND_SIZE 53
+#define DOUBLE_EXPONENT_BIAS (0x3FF + DOUBLE_SIGNIFICAND_SIZE - 1)
+#define DOUBLE_DENORMAL_EXPONENT (-DOUBLE_EXPONENT_BIAS + 1)
+#define DOUBLE_HIDDEN_BIT ((uint64_t)1 << (DOUBLE_SIGNIFICAND_SIZE - 1))
+#define DOUBLE_SIGNIFICAND_MASK (DOUBLE_HIDDEN_BIT - 1)
+#define DOUBLE_EXPONENT_MASK ((uint64_t)0x7FF << (DOUBLE_SIGNIFICAND_SIZE - 1))
+
+/* The scaled value w * 10**-k that digit generation works on has its binary exponent in
+   this range, so that its integral part fits in 32 bits. */
+#define GRISU_MIN_TARGET_EXPONENT (-60)
+#define GRISU_MAX_TARGET_EXPONENT (-32)
+
+static uint64_t
+double_to_bits(double d)
+{
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+static double
+bits_to_double(uint64_t bits)
+{
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+static diy_fp
+diy_fp_multiply(diy_fp x, diy_fp y)
+{
+    /* The upper 64 bits of the product, rounded to nearest. */
+    unsigned __int128 p = (unsigned __int128)x.f * y.f;
+    diy_fp r;
+    r.f = (uint64_t)(p >> 64) + (uint64_t)((p >> 63) & 1);
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+static diy_fp
+diy_fp_normalize(diy_fp x)
+{
+    int shift = __builtin_clzll(x.f);
+    x.f <<= shift;
+    x.e -= shift;
+    return x;
+}
+
+/* v as f * 2**e, with f including the hidden bit for normal numbers.  v must be finite and
+   positive. */
+static diy_fp
+double_to_diy_fp(double v)
+{
+    uint64_t bits = double_to_bits(v);
+    int biased_e = (int)((bits & DOUBLE_EXPONENT_MASK) >> (DOUBLE_SIGNIFICAND_SIZE - 1));
+    diy_fp r;
+    r.f = bits & DOUBLE_SIGNIFICAND_MASK;
+    if (biased_e == 0) {
+        r.e = DOUBLE_DENORMAL_EXPONENT;
+    }
+    else {
+        r.f += DOUBLE_HIDDEN_BIT;
+        r.e = biased_e - DOUBLE_EXPONENT_BIAS;
+    }
+    return r;
+}
+
+/* The boundaries m- and m+ of v: the midpoints between v and its neighbors, which delimit
+   the interval of values that read back as v.  Both get the exponent of the normalized
+   m+. */
+static void
+normalized_boundaries(double v, diy_fp *m_minus, diy_fp *m_plus)
+{
+    diy_fp w = double_to_diy_fp(v);
+    diy_fp plus, minus;
+    uint64_t bits = double_to_bits(v);
+
+    plus.f = (w.f << 1) + 1;
+    plus.e = w.e - 1;
+    plus = diy_fp_normalize(plus);
+
+    /* The lower neighbor is closer when v is a power of two (and not the smallest normal). */
+    if ((bits & DOUBLE_SIGNIFICAND_MASK) == 0 && (bits & DOUBLE_EXPONENT_MASK) > ((uint64_t)1 << 52)) {
+        minus.f = (w.f << 2) - 1;
+        minus.e = w.e - 2;
+    }
+    else {
+        minus.f = (w.f << 1) - 1;
+        minus.e = w.e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    *m_plus = plus;
+    *m_minus = minus;
+}
+
+/* Finds a cached power of ten c = 10**k such that the binary exponent of c * w falls into
+   [GRISU_MIN_TARGET_EXPONENT, GRISU_MAX_TARGET_EXPONENT], given w's binary exponent. */
+static diy_fp
+cached_power_for_exponent(int e, int *k)
+{
+    /* ceil((GRISU_MIN_TARGET_EXPONENT - (e + 64) + 63) * log10(2)) */
+    int min_exponent = GRISU_MIN_TARGET_EXPONENT - (e + 64);
+    int k_min = (int)ceil((min_exponent + 63) * 0.30102999566398114);
+    int index = (k_min - GRISU_MIN_EXP10 - 1) / GRISU_EXP10_STEP + 1;
+    diy_fp r;
+
+    assert(index >= 0 && index < GRISU_NUM_POWERS);
+    r.f = grisu_powers[index].f;
+    r.e = grisu_powers[index].e;
+    *k = grisu_powers[index].k;
+    assert(r.e + e + 64 >= GRISU_MIN_TARGET_EXPONENT && r.e + e + 64 <= GRISU_MAX_TARGET_EXPONENT);
+    return r;
+}
+
+static const uint32_t small_powers_of_ten[] = { 0, 1, 10, 100, 1000, 10000, 100000, 1000000,
+                                                10000000, 100000000, 1000000000 };
+
+/* The biggest power of ten that is <= number, where number < 2**(number_bits + 1).
+   Returns the power and stores its exponent plus one. */
+static uint32_t
+biggest_power_ten(uint32_t number, int number_bits, int *exponent_plus_one)
+{
+    /* 1233/4096 is approximately log10(2). */
+    int guess = ((number_bits + 1) * 1233 >> 12) + 1;
+    if (number < small_powers_of_ten[guess])
+        guess--;
+    *exponent_plus_one = guess;
+    return small_powers_of_ten[guess];
+}
+
+/* Adjusts the last digit of the shortest representation so that it is as close as possible
+   to w, and checks that the result is safe, ie that it is guaranteed to be inside the
+   rounding interval and to be the closest candidate despite the imprecision of the scaled
+   values.  All arguments are in units of the scaled value; see DigitGen in Loitsch's paper. */
+static int
+round_weed(char *buffer, int length, uint64_t distance_too_high_w, uint64_t unsafe_interval,
+           uint64_t rest, uint64_t ten_kappa, uint64_t unit)
+{
+    uint64_t small_distance = distance_too_high_w - unit;
+    uint64_t big_distance = distance_too_high_w + unit;
+
+    while (rest < small_distance && unsafe_interval - rest >= ten_kappa
+           && (rest + ten_kappa < small_distance || small_distance - rest >= rest + ten_kappa - small_distance)) {
+        buffer[length - 1]--;
+        rest += ten_kappa;
+    }
+
+    /* If the digit could be moved again towards the upper end of the uncertainty region, we
+       can't tell which candidate is the closer one. */
+    if (rest < big_distance && unsafe_interval - rest >= ten_kappa
+        && (rest + ten_kappa < big_distance || big_distance - rest > rest + ten_kappa - big_distance))
+        return 0;
+
+    return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+}
+
+/* Generates the shortest digits of w that lie strictly inside (low, high), where low and
+   high are the scaled boundaries and are imprecise by one unit each. */
+static int
+digit_gen(diy_fp low, diy_fp w, diy_fp high, char *buffer, int *length, int *kappa)
+{
+    uint64_t unit = 1;
+    diy_fp too_low = { low.f - unit, low.e };
+    diy_fp too_high = { high.f + unit, high.e };
+    uint64_t unsafe_interval = too_high.f - too_low.f;
+    int one_e = w.e;
+    uint64_t one_f = (uint64_t)1 << -one_e;
+    uint32_t integrals = (uint32_t)(too_high.f >> -one_e);
+    uint64_t fractionals = too_high.f & (one_f - 1);
+    int divisor_exponent_plus_one;
+    uint32_t divisor = biggest_power_ten(integrals, 64 - (-one_e), &divisor_exponent_plus_one);
+
+    *kappa = divisor_exponent_plus_one;
+    *length = 0;
+
+    while (*kappa > 0) {
+        uint64_t rest;
+        buffer[(*length)++] = (char)('0' + integrals / divisor);
+        integrals %= divisor;
+        (*kappa)--;
+        rest = ((uint64_t)integrals << -one_e) + fractionals;
+        if (rest < unsafe_interval)
+            return round_weed(buffer, *length, too_high.f - w.f, unsafe_interval, rest,
+                              (uint64_t)divisor << -one_e, unit);
+        divisor /= 10;
+    }
+
+    for (;;) {
+        fractionals *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        buffer[(*length)++] = (char)('0' + (fractionals >> -one_e));
+        fractionals &= one_f - 1;
+        (*kappa)--;
+        if (fractionals < unsafe_interval)
+            return round_weed(buffer, *length, (too_high.f - w.f) * unit, unsafe_interval, fractionals, one_f,
+                              unit);
+    }
+}
+
+/* Rounds the digits that digit_gen_counted generated, given the rest that didn't make it
+   into them, or fails if the imprecision of the scaled value makes the direction
+   ambiguous. */
+static int
+round_weed_counted(char *buffer, int length, uint64_t rest, uint64_t ten_kappa, uint64_t unit, int *kappa)
+{
+    int i;
+
+    assert(rest < ten_kappa);
+    if (unit >= ten_kappa || ten_kappa - unit <= unit)
+        return 0;
+
+    /* rest + unit < ten_kappa / 2: round down. */
+    if (ten_kappa - rest > rest && ten_kappa - 2 * rest >= 2 * unit)
+        return 1;
+
+    /* rest - unit > ten_kappa / 2: round up. */
+    if (rest > unit && ten_kappa - (rest - unit) <= (rest - unit)) {
+        buffer[length - 1]++;
+        for (i = length - 1; i > 0; --i) {
+            if (buffer[i] != '0' + 10)
+                break;
+            buffer[i] = '0';
+            buffer[i - 1]++;
+        }
+        if (buffer[0] == '0' + 10) {
+            buffer[0] = '1';
+            (*kappa)++;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+/* Generates the first requested_digits digits of w, correctly rounded. */
+static int
+digit_gen_counted(diy_fp w, int requested_digits, char *buffer, int *length, int *kappa)
+{
+    uint64_t w_error = 1;
+    int one_e = w.e;
+    uint64_t one_f = (uint64_t)1 << -one_e;
+    uint32_t integrals = (uint32_t)(w.f >> -one_e);
+    uint64_t fractionals = w.f & (one_f - 1);
+    int divisor_exponent_plus_one;
+    uint32_t divisor = biggest_power_ten(integrals, 64 - (-one_e), &divisor_exponent_plus_one);
+
+    *kappa = divisor_exponent_plus_one;
+    *length = 0;
+
+    while (*kappa > 0) {
+        buffer[(*length)++] = (char)('0' + integrals / divisor);
+        requested_digits--;
+        integrals %= divisor;
+        (*kappa)--;
+        if (requested_digits == 0)
+            break;
+        divisor /= 10;
+    }
+
+    if (requested_digits == 0) {
+        uint64_t rest = ((uint64_t)integrals << -one_e) + fractionals;
+        return round_weed_counted(buffer, *length, rest, (uint64_t)divisor << -one_e, w_error, kappa);
+    }
+
+    while (requested_digits > 0 && fractionals > w_error) {
+        fractionals *= 10;
+        w_error *= 10;
+        buffer[(*length)++] = (char)('0' + (fractionals >> -one_e));
+        requested_digits--;
+        fractionals &= one_f - 1;
+        (*kappa)--;
+    }
+    if (requested_digits != 0)
+        return 0;
+    return round_weed_counted(buffer, *length, fractionals, one_f, w_error, kappa);
+}
+
+/* Shortest digits of d > 0, see digit_gen. */
+static int
+grisu3_shortest(double d, char *digits, int *length, int *decimal_exponent)
+{
+    diy_fp w = diy_fp_normalize(double_to_diy_fp(d));
+    diy_fp boundary_minus, boundary_plus, ten_mk;
+    int mk, kappa;
+
+    normalized_boundaries(d, &boundary_minus, &boundary_plus);
+    assert(boundary_plus.e == w.e);
+    ten_mk = cached_power_for_exponent(w.e, &mk);
+    if (!digit_gen(diy_fp_multiply(boundary_minus, ten_mk), diy_fp_multiply(w, ten_mk),
+                   diy_fp_multiply(boundary_plus, ten_mk), digits, length, &kappa))
+        return 0;
+    *decimal_exponent = kappa - mk;
+    return 1;
+}
+
+/* The first ndigits digits of d > 0, correctly rounded, see digit_gen_counted. */
+static int
+grisu3_counted(double d, int ndigits, char *digits, int *length, int *decimal_exponent)
+{
+    diy_fp w = diy_fp_normalize(double_to_diy_fp(d));
+    diy_fp ten_mk;
+    int mk, kappa;
+
+    ten_mk = cached_power_for_exponent(w.e, &mk);
+    if (!digit_gen_counted(diy_fp_multiply(w, ten_mk), ndigits, digits, length, &kappa))
+        return 0;
+    *decimal_exponent = kappa - mk;
+    return 1;
+}
+
+int
+_Py_fast_dtoa(double d, int mode, int ndigits, char *digits, int *decpt, int *sign, char **rve)
+{
+    uint64_t bits = double_to_bits(d);
+    int length, decimal_exponent;
+
+    if ((bits & DOUBLE_EXPONENT_MASK) == DOUBLE_EXPONENT_MASK)
+        return 0; /* inf or nan */
+    if (mode != 0 && (mode != 2 || ndigits <= 0 || ndigits > FAST_DTOA_MAX_DIGITS))
+        return 0;
+
+    *sign = (int)(bits >> 63);
+    d = fabs(d);
+
+    if (d == 0.0) {
+        digits[0] = '0';
+        *decpt = 1;
+        *rve = digits + 1;
+        return 1;
+    }
+
+    if (mode == 0) {
+        if (!grisu3_shortest(d, digits, &length, &decimal_exponent))
+            return 0;
+    }
+    else if (!grisu3_counted(d, ndigits, digits, &length, &decimal_exponent)) {
+        /* Counted digit generation gives up when d has fewer significant digits than
+           requested, eg str(5.0).  If the shortest representation fits, it is also the
+           correctly rounded one, as long as ndigits <= 15: rounding d to that many digits
+           needs a precision of at least 5e-16 relative to d, and the shortest representation
+           is within half an ulp (at most 2**-53 relative to d) of it. */
+        if (ndigits > 15 || !grisu3_shortest(d, digits, &length, &decimal_exponent) || length > ndigits)
+            return 0;
+    }
+
+    /* Like _Py_dg_dtoa, don't return trailing zeros. */
+    while (length > 1 && digits[length - 1] == '0') {
+        length--;
+        decimal_exponent++;
+    }
+
+    /* The digits represent digits * 10**decimal_exponent. */
+    *decpt = length + decimal_exponent;
+    *rve = digits + length;
+    return 1;
+}
+
+/* Clinger's fast path: a significand below 2**53 and a power of ten up to 1e22 are both
+   exact doubles, so a single correctly rounded multiplication or division gives the
+   correctly rounded result. */
+static const double exact_powers_of_ten[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                              1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                              1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+/* Computes man * 10**exp10 correctly rounded, or fails if that can't be done cheaply. */
+static int
+eisel_lemire(uint64_t man, int exp10, int negative, double *result)
+{
+    const uint64_t *power;
+    unsigned __int128 x;
+    uint64_t x_hi, x_lo, ret_mantissa, ret_exp2, msb;
+    int clz;
+
+    if (man == 0) {
+        *result = negative ? -0.0 : 0.0;
+        return 1;
+    }
+    if (exp10 < LEMIRE_MIN_EXP10 || exp10 > LEMIRE_MAX_EXP10)
+        return 0;
+    power = lemire_powers[exp10 - LEMIRE_MIN_EXP10];
+
+    /* Normalize the significand, and compute the binary exponent of the result:
+       217706 / 2**16 is approximately log2(10). */
+    clz = __builtin_clzll(man);
+    man <<= clz;
+    ret_exp2 = (uint64_t)(((217706 * exp10) >> 16) + 64 + 0x3FF) - (uint64_t)clz;
+
+    /* Multiply by the upper 64 bits of the power of ten. */
+    x = (unsigned __int128)man * power[0];
+    x_hi = (uint64_t)(x >> 64);
+    x_lo = (uint64_t)x;
+
+    /* If the bits below the 54 we keep are all ones, the truncated power might have pushed
+       the product just below a rounding boundary; use the lower 64 bits of the power too. */
+    if ((x_hi & 0x1FF) == 0x1FF && x_lo + man < man) {
+        unsigned __int128 y = (unsigned __int128)man * power[1];
+        uint64_t y_hi = (uint64_t)(y >> 64);
+        uint64_t y_lo = (uint64_t)y;
+        uint64_t merged_hi = x_hi;
+        uint64_t merged_lo = x_lo + y_hi;
+        if (merged_lo < x_lo)
+            merged_hi++;
+        if ((merged_hi & 0x1FF) == 0x1FF && merged_lo + 1 == 0 && y_lo + man < man)
+            return 0;
+        x_hi = merged_hi;
+        x_lo = merged_lo;
+    }
+
+    /* Keep 54 bits: the 53 of the result and one for rounding. */
+    msb = x_hi >> 63;
+    ret_mantissa = x_hi >> (msb + 9);
+    ret_exp2 -= 1 ^ msb;
+
+    /* If the product looks like it's exactly halfway between two doubles, the bits that
+       the truncated power lost decide the direction. */
+    if (x_lo == 0 && (x_hi & 0x1FF) == 0 && (ret_mantissa & 3) == 1)
+        return 0;
+
+    /* Round to 53 bits, half to even. */
+    ret_mantissa += ret_mantissa & 1;
+    ret_mantissa >>= 1;
+    if (ret_mantissa >> 53) {
+        ret_mantissa >>= 1;
+        ret_exp2 += 1;
+    }
+
+    /* Leave subnormals, infinities (and the errno handling for them) to dtoa.c. */
+    if (ret_exp2 - 1 >= 0x7FF - 1)
+        return 0;
+
+    *result = bits_to_double((ret_exp2 << 52) | (ret_mantissa & DOUBLE_SIGNIFICAND_MASK)
+                             | ((uint64_t)negative << 63));
+    return 1;
+}
+
+int
+_Py_fast_strtod(const char *s00, char **se, double *result)
+{
+    const char *s = s00;
+    uint64_t man = 0;
+    int negative = 0, ndigits = 0, any_digits = 0, exp10 = 0;
+
+    if (*s == '-') {
+        negative = 1;
+        s++;
+    }
+    else if (*s == '+') {
+        s++;
+    }
+
+    /* Leading zeros are not significant. */
+    while (*s == '0') {
+        any_digits = 1;
+        s++;
+    }
+    while ('0' <= *s && *s <= '9') {
+        if (ndigits == 19)
+            return 0;
+        man = man * 10 + (uint64_t)(*s - '0');
+        ndigits++;
+        s++;
+    }
+    if (*s == '.') {
+        s++;
+        if (ndigits == 0) {
+            while (*s == '0') {
+                any_digits = 1;
+                exp10--;
+                s++;
+            }
+        }
+        while ('0' <= *s && *s <= '9') {
+            if (ndigits == 19)
+                return 0;
+            man = man * 10 + (uint64_t)(*s - '0');
+            ndigits++;
+            exp10--;
+            s++;
+        }
+    }
+    if (!ndigits && !any_digits)
+        return 0;
+
+    if (*s == 'e' || *s == 'E') {
+        const char *p = s + 1;
+        int esign = 1, e = 0, edigits = 0;
+        if (*p == '-') {
+            esign = -1;
+            p++;
+        }
+        else if (*p == '+') {
+            p++;
+        }
+        /* Incomplete and very long exponents are rare enough to leave to dtoa.c. */
+        while ('0' <= *p && *p <= '9') {
+            if (++edigits > 4)
+                return 0;
+            e = e * 10 + (*p - '0');
+            p++;
+        }
+        if (!edigits)
+            return 0;
+        exp10 += esign * e;
+        s = p;
+    }
+
+    if (man < ((uint64_t)1 << DOUBLE_SIGNIFICAND_SIZE) && exp10 >= -22 && exp10 <= 22) {
+        double d = (double)man;
+        if (exp10 < 0)
+            d /= exact_powers_of_ten[-exp10];
+        else
+            d *= exact_powers_of_ten[exp10];
+        *result = negative ? -d : d;
+    }
+    else if (!eisel_lemire(man, exp10, negative, result)) {
+        return 0;
+    }
+
+    *se = (char *)s;
+    return 1;
+}
+
+#endif /* PY_NO_SHORT_FLOAT_REPR */
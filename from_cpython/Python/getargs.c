@@ -37,6 +37,8 @@ PyAPI_FUNC(int) _PyArg_VaParseTupleAndKeywords_SizeT(PyObject *, PyObject *,
 
 /* Forward */
 static int vgetargs1(PyObject *, const char *, va_list *, int);
+static int vgetargs1_impl(PyObject *, PyObject **, Py_ssize_t, const char *,
+                          va_list *, int);
 static void seterror(int, const char *, int *, const char *, const char *);
 static char *convertitem(PyObject *, const char **, va_list *, int, int *,
                          char *, size_t, PyObject **);
@@ -49,8 +51,226 @@ static int getbuffer(PyObject *, Py_buffer *, char**);
 
 static int vgetargskeywords(PyObject *, PyObject *,
                             const char *, char **, va_list *, int);
+static int vgetargskeywords_impl(PyObject **, Py_ssize_t, PyObject *,
+                                 PyObject *, const char *, char **,
+                                 va_list *, int);
+static int vgetargskeywords_convert(PyObject **, Py_ssize_t, PyObject *,
+                                    PyObject *, const char *, char **,
+                                    va_list *, int, const char *,
+                                    const char *, int, PyObject **);
 static char *skipitem(const char **, va_list *, int);
 
+/* Pyston addition: caches of the information we get from scanning a format
+   string (and for the keywords variants, the keyword list) before converting
+   any arguments.  Format strings and keyword lists are almost always static
+   data, so the caches are keyed on their addresses.  The memory of a format
+   can still get reused for a different one (a buffer on the stack, or a
+   string a C extension freed), and using the information of the old format
+   for the new one would walk past its end.  So entries also keep a copy of
+   the format, which a hit compares against; formats that don't fit in it
+   (only very few do not) don't get cached.  Formats that live in a buffer
+   on the stack most likely change all the time, and aren't cached either.
+
+   The caches are 2-way set associative.  Each entry has a small hit counter;
+   a miss in a full set decrements the smaller counter of the two and only
+   replaces that entry once its counter is zero.  So hot formats that share a
+   set don't keep evicting each other, and a format that keeps missing just
+   doesn't get cached.  The caches are protected by the GIL. */
+
+#define FORMAT_CACHE_SETS 128
+#define FORMAT_CACHE_WAYS 2
+#define FORMAT_CACHE_MAX_HITS 3
+#define FORMAT_STACK_WINDOW (1 << 20)
+#define KWFORMAT_MAX_KEYWORDS 16
+#define FORMAT_CACHE_MAX_LEN 32
+
+typedef struct {
+    const char *format;
+    char text[FORMAT_CACHE_MAX_LEN];
+    unsigned char hits;
+    int min, max;
+    /* Offsets of the function name / custom message in format, or -1. */
+    int fname_offset, message_offset;
+} format_cache_entry;
+
+typedef struct {
+    const char *format;
+    char text[FORMAT_CACHE_MAX_LEN];
+    char **kwlist;
+    unsigned char hits;
+    int len;
+    int fname_offset, message_offset;
+    /* Number of active calls using keywords; the entry can't be replaced
+       while this is nonzero. */
+    int in_use;
+    /* Interned strings for each of the entries of kwlist. */
+    PyObject *keywords[KWFORMAT_MAX_KEYWORDS];
+} kwformat_cache_entry;
+
+static format_cache_entry format_cache[FORMAT_CACHE_SETS][FORMAT_CACHE_WAYS];
+static kwformat_cache_entry kwformat_cache[FORMAT_CACHE_SETS][FORMAT_CACHE_WAYS];
+
+static size_t
+format_cache_set(const void *format, const void *kwlist)
+{
+    size_t h = (size_t)format ^ ((size_t)kwlist >> 4);
+    h ^= h >> 11;
+    return (h >> 3) & (FORMAT_CACHE_SETS - 1);
+}
+
+/* Whether format can be cached: it has to fit into the copy in the entry,
+   and formats that are within a megabyte above our own stack frame probably
+   live in a caller's frame. */
+static int
+format_is_cacheable(const char *format)
+{
+    char marker;
+    return (uintptr_t)format - (uintptr_t)&marker >= FORMAT_STACK_WINDOW &&
+           strnlen(format, FORMAT_CACHE_MAX_LEN) < FORMAT_CACHE_MAX_LEN;
+}
+
+static void
+note_hit(unsigned char *hits)
+{
+    if (*hits < FORMAT_CACHE_MAX_HITS)
+        (*hits)++;
+}
+
+/* Returns the way of a full set to replace (or an empty one), or -1 if
+   nothing should get replaced this time.  hits[i] is NULL for ways that
+   can't be replaced right now. */
+static int
+choose_victim(unsigned char *hits[FORMAT_CACHE_WAYS],
+              const void *formats[FORMAT_CACHE_WAYS])
+{
+    int i, victim = -1;
+    for (i = 0; i < FORMAT_CACHE_WAYS; i++) {
+        if (hits[i] == NULL)
+            continue;
+        if (formats[i] == NULL)
+            return i;
+        if (victim == -1 || *hits[i] < *hits[victim])
+            victim = i;
+    }
+    if (victim == -1)
+        return -1;
+    if (*hits[victim] > 0) {
+        (*hits[victim])--;
+        return -1;
+    }
+    return victim;
+}
+
+static format_cache_entry *
+lookup_format(const char *format)
+{
+    format_cache_entry *set = format_cache[format_cache_set(format, NULL)];
+    int i;
+    for (i = 0; i < FORMAT_CACHE_WAYS; i++) {
+        if (set[i].format == format && strcmp(set[i].text, format) == 0) {
+            note_hit(&set[i].hits);
+            return &set[i];
+        }
+    }
+    return NULL;
+}
+
+static void
+store_format(const char *format, int min, int max, const char *fname,
+             const char *message)
+{
+    format_cache_entry *set = format_cache[format_cache_set(format, NULL)];
+    format_cache_entry *entry;
+    unsigned char *hits[FORMAT_CACHE_WAYS];
+    const void *formats[FORMAT_CACHE_WAYS];
+    int i;
+
+    if (!format_is_cacheable(format))
+        return;
+
+    for (i = 0; i < FORMAT_CACHE_WAYS; i++) {
+        hits[i] = &set[i].hits;
+        formats[i] = set[i].format;
+    }
+    i = choose_victim(hits, formats);
+    if (i < 0)
+        return;
+
+    entry = &set[i];
+    entry->format = format;
+    strcpy(entry->text, format);
+    entry->hits = 0;
+    entry->min = min;
+    entry->max = max;
+    entry->fname_offset = fname == NULL ? -1 : (int)(fname - format);
+    entry->message_offset = message == NULL ? -1 : (int)(message - format);
+}
+
+static kwformat_cache_entry *
+lookup_kwformat(const char *format, char **kwlist)
+{
+    kwformat_cache_entry *set =
+        kwformat_cache[format_cache_set(format, kwlist)];
+    int i;
+    for (i = 0; i < FORMAT_CACHE_WAYS; i++) {
+        if (set[i].format == format && set[i].kwlist == kwlist &&
+            strcmp(set[i].text, format) == 0) {
+            note_hit(&set[i].hits);
+            return &set[i];
+        }
+    }
+    return NULL;
+}
+
+static kwformat_cache_entry *
+store_kwformat(const char *format, char **kwlist, int len,
+               const char *fname, const char *message)
+{
+    kwformat_cache_entry *set =
+        kwformat_cache[format_cache_set(format, kwlist)];
+    kwformat_cache_entry *entry;
+    unsigned char *hits[FORMAT_CACHE_WAYS];
+    const void *formats[FORMAT_CACHE_WAYS];
+    PyObject *keywords[KWFORMAT_MAX_KEYWORDS];
+    int i;
+
+    if (len > KWFORMAT_MAX_KEYWORDS || !format_is_cacheable(format))
+        return NULL;
+
+    for (i = 0; i < FORMAT_CACHE_WAYS; i++) {
+        hits[i] = set[i].in_use ? NULL : &set[i].hits;
+        formats[i] = set[i].format;
+    }
+    i = choose_victim(hits, formats);
+    if (i < 0)
+        return NULL;
+    entry = &set[i];
+
+    for (i = 0; i < len; i++) {
+        keywords[i] = PyString_InternFromString(kwlist[i]);
+        if (keywords[i] == NULL) {
+            PyErr_Clear();
+            while (--i >= 0)
+                Py_DECREF(keywords[i]);
+            return NULL;
+        }
+    }
+
+    for (i = 0; i < entry->len; i++)
+        Py_DECREF(entry->keywords[i]);
+    for (i = 0; i < len; i++)
+        entry->keywords[i] = keywords[i];
+
+    entry->format = format;
+    strcpy(entry->text, format);
+    entry->kwlist = kwlist;
+    entry->hits = 0;
+    entry->len = len;
+    entry->fname_offset = fname == NULL ? -1 : (int)(fname - format);
+    entry->message_offset = message == NULL ? -1 : (int)(message - format);
+    return entry;
+}
+
 int
 PyArg_Parse(PyObject *args, const char *format, ...)
 {
@@ -220,6 +440,26 @@ cleanreturn(int retval, PyObject *freelist)
 
 static int
 vgetargs1(PyObject *args, const char *format, va_list *p_va, int flags)
+{
+    if (flags & FLAG_COMPAT)
+        return vgetargs1_impl(args, NULL, 0, format, p_va, flags);
+
+    if (!PyTuple_Check(args)) {
+        PyErr_SetString(PyExc_SystemError,
+            "new style getargs format but argument is not a tuple");
+        return 0;
+    }
+
+    return vgetargs1_impl(NULL, &PyTuple_GET_ITEM(args, 0),
+                          PyTuple_GET_SIZE(args), format, p_va, flags);
+}
+
+/* Pyston change: the new-style arguments are taken as an array, so that
+   METH_FASTCALL functions can be parsed without building a tuple.  For
+   FLAG_COMPAT, compat_args is the single (possibly NULL) argument. */
+static int
+vgetargs1_impl(PyObject *compat_args, PyObject **stack, Py_ssize_t nargs,
+               const char *format, va_list *p_va, int flags)
 {
     char msgbuf[256];
     int levels[32];
@@ -234,10 +474,23 @@ vgetargs1(PyObject *args, const char *format, va_list *p_va, int flags)
     char *msg;
     PyObject *freelist = NULL;
     int compat = flags & FLAG_COMPAT;
+    format_cache_entry *cached;
 
-    assert(compat || (args != (PyObject*)NULL));
+    assert(compat || nargs == 0 || stack != NULL);
     flags = flags & ~FLAG_COMPAT;
 
+    /* Pyston change: reuse the results of scanning the format string */
+    cached = lookup_format(format);
+    if (cached != NULL) {
+        min = cached->min;
+        max = cached->max;
+        if (cached->fname_offset >= 0)
+            fname = format + cached->fname_offset;
+        if (cached->message_offset >= 0)
+            message = format + cached->message_offset;
+        endfmt = 1;
+    }
+
     while (endfmt == 0) {
         int c = *format++;
         switch (c) {
@@ -288,9 +541,12 @@ vgetargs1(PyObject *args, const char *format, va_list *p_va, int flags)
 
     format = formatsave;
 
+    if (cached == NULL)
+        store_format(format, min, max, fname, message);
+
     if (compat) {
         if (max == 0) {
-            if (args == NULL)
+            if (compat_args == NULL)
                 return 1;
             PyOS_snprintf(msgbuf, sizeof(msgbuf),
                           "%.200s%s takes no arguments",
@@ -300,7 +556,7 @@ vgetargs1(PyObject *args, const char *format, va_list *p_va, int flags)
             return 0;
         }
         else if (min == 1 && max == 1) {
-            if (args == NULL) {
+            if (compat_args == NULL) {
                 PyOS_snprintf(msgbuf, sizeof(msgbuf),
                       "%.200s%s takes at least one argument",
                           fname==NULL ? "function" : fname,
@@ -308,7 +564,7 @@ vgetargs1(PyObject *args, const char *format, va_list *p_va, int flags)
                 PyErr_SetString(PyExc_TypeError, msgbuf);
                 return 0;
             }
-            msg = convertitem(args, &format, p_va, flags, levels,
+            msg = convertitem(compat_args, &format, p_va, flags, levels,
                               msgbuf, sizeof(msgbuf), &freelist);
             if (msg == NULL)
                 return cleanreturn(1, freelist);
@@ -322,13 +578,7 @@ vgetargs1(PyObject *args, const char *format, va_list *p_va, int flags)
         }
     }
 
-    if (!PyTuple_Check(args)) {
-        PyErr_SetString(PyExc_SystemError,
-            "new style getargs format but argument is not a tuple");
-        return 0;
-    }
-
-    len = PyTuple_GET_SIZE(args);
+    len = nargs;
 
     if (len < min || max < len) {
         if (message == NULL) {
@@ -351,7 +601,7 @@ vgetargs1(PyObject *args, const char *format, va_list *p_va, int flags)
     for (i = 0; i < len; i++) {
         if (*format == '|')
             format++;
-        msg = convertitem(PyTuple_GET_ITEM(args, i), &format, p_va,
+        msg = convertitem(stack[i], &format, p_va,
                           flags, levels, msgbuf,
                           sizeof(msgbuf), &freelist);
         if (msg) {
@@ -1605,37 +1855,131 @@ static int
 vgetargskeywords(PyObject *args, PyObject *keywords, const char *format,
                  char **kwlist, va_list *p_va, int flags)
 {
-    char msgbuf[512];
-    int levels[32];
-    const char *fname, *msg, *custom_msg, *keyword;
-    int min = INT_MAX;
-    int i, len, nargs, nkeywords;
-    PyObject *freelist = NULL, *current_arg;
-
     assert(args != NULL && PyTuple_Check(args));
+    return vgetargskeywords_impl(&PyTuple_GET_ITEM(args, 0),
+                                 PyTuple_GET_SIZE(args), keywords, NULL,
+                                 format, kwlist, p_va, flags);
+}
+
+/* Pyston addition: looks up a keyword argument, either in the keywords dict
+   or, for METH_FASTCALL functions, in kwnames (whose values are kwstack). */
+static PyObject *
+find_keyword(PyObject *keywords, PyObject *kwnames, PyObject **kwstack,
+             const char *key, PyObject *key_obj)
+{
+    Py_ssize_t i, n;
+
+    if (keywords != NULL) {
+        if (key_obj != NULL)
+            return PyDict_GetItem(keywords, key_obj);
+        return PyDict_GetItemString(keywords, key);
+    }
+
+    /* The names come from the call, which only allows strings.  They are
+       usually interned, so check for the interned key_obj first. */
+    n = PyTuple_GET_SIZE(kwnames);
+    if (key_obj != NULL) {
+        for (i = 0; i < n; i++) {
+            if (PyTuple_GET_ITEM(kwnames, i) == key_obj)
+                return kwstack[i];
+        }
+    }
+    for (i = 0; i < n; i++) {
+        if (!strcmp(PyString_AS_STRING(PyTuple_GET_ITEM(kwnames, i)), key))
+            return kwstack[i];
+    }
+    return NULL;
+}
+
+/* Pyston change: the positional arguments are taken as an array, and the
+   keywords as either a dict or (for METH_FASTCALL) a tuple of names whose
+   values follow the positional arguments in stack. */
+static int
+vgetargskeywords_impl(PyObject **stack, Py_ssize_t stack_nargs,
+                      PyObject *keywords, PyObject *kwnames,
+                      const char *format, char **kwlist, va_list *p_va,
+                      int flags)
+{
+    const char *fname, *custom_msg;
+    int len, retval;
+    kwformat_cache_entry *cached;
+
+    assert(stack != NULL || stack_nargs == 0);
     assert(keywords == NULL || PyDict_Check(keywords));
+    assert(kwnames == NULL || (keywords == NULL && PyTuple_Check(kwnames)));
     assert(format != NULL);
     assert(kwlist != NULL);
     assert(p_va != NULL);
 
-    /* grab the function name or custom error msg first (mutually exclusive) */
-    fname = strchr(format, ':');
-    if (fname) {
-        fname++;
-        custom_msg = NULL;
+    /* Pyston change: reuse the results of scanning the format string and
+       kwlist, including interned versions of the keywords */
+    cached = lookup_kwformat(format, kwlist);
+    if (cached != NULL) {
+        fname = cached->fname_offset >= 0 ? format + cached->fname_offset
+                                          : NULL;
+        custom_msg = cached->message_offset >= 0
+                         ? format + cached->message_offset
+                         : NULL;
+        len = cached->len;
     }
     else {
-        custom_msg = strchr(format,';');
-        if (custom_msg)
-            custom_msg++;
+        /* grab the function name or custom error msg first (mutually exclusive) */
+        fname = strchr(format, ':');
+        if (fname) {
+            fname++;
+            custom_msg = NULL;
+        }
+        else {
+            custom_msg = strchr(format,';');
+            if (custom_msg)
+                custom_msg++;
+        }
+
+        /* scan kwlist and get greatest possible nbr of args */
+        for (len=0; kwlist[len]; len++)
+            continue;
+
+        cached = store_kwformat(format, kwlist, len, fname, custom_msg);
     }
 
-    /* scan kwlist and get greatest possible nbr of args */
-    for (len=0; kwlist[len]; len++)
-        continue;
+    if (cached == NULL)
+        return vgetargskeywords_convert(stack, stack_nargs, keywords, kwnames,
+                                        format, kwlist, p_va, flags, fname,
+                                        custom_msg, len, NULL);
+
+    /* Converters can call back into Python code that parses arguments, so
+       make sure the entry doesn't get replaced while we use its keywords. */
+    cached->in_use++;
+    retval = vgetargskeywords_convert(stack, stack_nargs, keywords, kwnames,
+                                      format, kwlist, p_va, flags, fname,
+                                      custom_msg, len, cached->keywords);
+    cached->in_use--;
+    return retval;
+}
+
+/* Pyston change: split out of vgetargskeywords_impl.  kwobjs, if non-NULL,
+   holds interned strings for the entries of kwlist. */
+static int
+vgetargskeywords_convert(PyObject **stack, Py_ssize_t stack_nargs,
+                         PyObject *keywords, PyObject *kwnames,
+                         const char *format, char **kwlist, va_list *p_va,
+                         int flags, const char *fname, const char *custom_msg,
+                         int len, PyObject **kwobjs)
+{
+    char msgbuf[512];
+    int levels[32];
+    const char *msg, *keyword;
+    int min = INT_MAX;
+    int i, nargs, nkeywords;
+    PyObject *freelist = NULL, *current_arg;
 
-    nargs = PyTuple_GET_SIZE(args);
-    nkeywords = (keywords == NULL) ? 0 : PyDict_Size(keywords);
+    nargs = stack_nargs;
+    if (keywords != NULL)
+        nkeywords = PyDict_Size(keywords);
+    else if (kwnames != NULL)
+        nkeywords = PyTuple_GET_SIZE(kwnames);
+    else
+        nkeywords = 0;
     if (nargs + nkeywords > len) {
         PyErr_Format(PyExc_TypeError, "%s%s takes at most %d "
                      "argument%s (%d given)",
@@ -1662,7 +2006,8 @@ vgetargskeywords(PyObject *args, PyObject *keywords, const char *format,
         }
         current_arg = NULL;
         if (nkeywords) {
-            current_arg = PyDict_GetItemString(keywords, keyword);
+            current_arg = find_keyword(keywords, kwnames, stack + nargs,
+                                       keyword, kwobjs ? kwobjs[i] : NULL);
         }
         if (current_arg) {
             --nkeywords;
@@ -1678,7 +2023,7 @@ vgetargskeywords(PyObject *args, PyObject *keywords, const char *format,
         else if (nkeywords && PyErr_Occurred())
             return cleanreturn(0, freelist);
         else if (i < nargs)
-            current_arg = PyTuple_GET_ITEM(args, i);
+            current_arg = stack[i];
 
         if (current_arg) {
             msg = convertitem(current_arg, &format, p_va, flags,
@@ -1721,7 +2066,24 @@ vgetargskeywords(PyObject *args, PyObject *keywords, const char *format,
     }
 
     /* make sure there are no extraneous keyword arguments */
-    if (nkeywords > 0) {
+    if (nkeywords > 0 && kwnames != NULL) {
+        Py_ssize_t j;
+        for (j = 0; j < PyTuple_GET_SIZE(kwnames); j++) {
+            char *ks = PyString_AS_STRING(PyTuple_GET_ITEM(kwnames, j));
+            for (i = 0; i < len; i++) {
+                if (!strcmp(ks, kwlist[i]))
+                    break;
+            }
+            if (i == len) {
+                PyErr_Format(PyExc_TypeError,
+                             "'%s' is an invalid keyword "
+                             "argument for this function",
+                             ks);
+                return cleanreturn(0, freelist);
+            }
+        }
+    }
+    else if (nkeywords > 0) {
         PyObject *key, *value;
         Py_ssize_t pos = 0;
         while (PyDict_Next(keywords, &pos, &key, &value)) {
@@ -1887,28 +2249,15 @@ err:
 }
 
 
-int
-PyArg_UnpackTuple(PyObject *args, const char *name, Py_ssize_t min, Py_ssize_t max, ...)
+static int
+unpack_stack(PyObject **args, Py_ssize_t l, const char *name,
+             Py_ssize_t min, Py_ssize_t max, va_list vargs)
 {
-    Py_ssize_t i, l;
+    Py_ssize_t i;
     PyObject **o;
-    va_list vargs;
-
-#ifdef HAVE_STDARG_PROTOTYPES
-    va_start(vargs, max);
-#else
-    va_start(vargs);
-#endif
 
     assert(min >= 0);
     assert(min <= max);
-    if (!PyTuple_Check(args)) {
-        va_end(vargs);
-        PyErr_SetString(PyExc_SystemError,
-            "PyArg_UnpackTuple() argument list is not a tuple");
-        return 0;
-    }
-    l = PyTuple_GET_SIZE(args);
     if (l < min) {
         if (name != NULL)
             PyErr_Format(
@@ -1921,7 +2270,6 @@ PyArg_UnpackTuple(PyObject *args, const char *name, Py_ssize_t min, Py_ssize_t m
                 "unpacked tuple should have %s%zd elements,"
                 " but has %zd",
                 (min == max ? "" : "at least "), min, l);
-        va_end(vargs);
         return 0;
     }
     if (l > max) {
@@ -1936,17 +2284,132 @@ PyArg_UnpackTuple(PyObject *args, const char *name, Py_ssize_t min, Py_ssize_t m
                 "unpacked tuple should have %s%zd elements,"
                 " but has %zd",
                 (min == max ? "" : "at most "), max, l);
-        va_end(vargs);
         return 0;
     }
     for (i = 0; i < l; i++) {
         o = va_arg(vargs, PyObject **);
-        *o = PyTuple_GET_ITEM(args, i);
+        *o = args[i];
     }
-    va_end(vargs);
     return 1;
 }
 
+int
+PyArg_UnpackTuple(PyObject *args, const char *name, Py_ssize_t min, Py_ssize_t max, ...)
+{
+    int retval;
+    va_list vargs;
+
+    if (!PyTuple_Check(args)) {
+        PyErr_SetString(PyExc_SystemError,
+            "PyArg_UnpackTuple() argument list is not a tuple");
+        return 0;
+    }
+
+#ifdef HAVE_STDARG_PROTOTYPES
+    va_start(vargs, max);
+#else
+    va_start(vargs);
+#endif
+    retval = unpack_stack(&PyTuple_GET_ITEM(args, 0), PyTuple_GET_SIZE(args),
+                          name, min, max, vargs);
+    va_end(vargs);
+    return retval;
+}
+
+
+/* Pyston addition: argument parsing for METH_FASTCALL functions.  These
+   work like their tuple-based counterparts above, except that the
+   positional arguments are the array args[0:nargs], and any keyword
+   arguments are named by the kwnames tuple with their values following the
+   positional ones in args. */
+
+int
+_PyArg_ParseStack(PyObject **args, Py_ssize_t nargs, const char *format, ...)
+{
+    int retval;
+    va_list va;
+
+    va_start(va, format);
+    retval = vgetargs1_impl(NULL, args, nargs, format, &va, 0);
+    va_end(va);
+    return retval;
+}
+
+int
+_PyArg_ParseStack_SizeT(PyObject **args, Py_ssize_t nargs, const char *format, ...)
+{
+    int retval;
+    va_list va;
+
+    va_start(va, format);
+    retval = vgetargs1_impl(NULL, args, nargs, format, &va, FLAG_SIZE_T);
+    va_end(va);
+    return retval;
+}
+
+int
+_PyArg_ParseStackAndKeywords(PyObject **args, Py_ssize_t nargs,
+                             PyObject *kwnames, const char *format,
+                             char **kwlist, ...)
+{
+    int retval;
+    va_list va;
+
+    if ((kwnames != NULL && !PyTuple_Check(kwnames)) ||
+        format == NULL ||
+        kwlist == NULL)
+    {
+        PyErr_BadInternalCall();
+        return 0;
+    }
+
+    va_start(va, kwlist);
+    retval = vgetargskeywords_impl(args, nargs, NULL, kwnames, format,
+                                   kwlist, &va, 0);
+    va_end(va);
+    return retval;
+}
+
+int
+_PyArg_ParseStackAndKeywords_SizeT(PyObject **args, Py_ssize_t nargs,
+                                   PyObject *kwnames, const char *format,
+                                   char **kwlist, ...)
+{
+    int retval;
+    va_list va;
+
+    if ((kwnames != NULL && !PyTuple_Check(kwnames)) ||
+        format == NULL ||
+        kwlist == NULL)
+    {
+        PyErr_BadInternalCall();
+        return 0;
+    }
+
+    va_start(va, kwlist);
+    retval = vgetargskeywords_impl(args, nargs, NULL, kwnames, format,
+                                   kwlist, &va, FLAG_SIZE_T);
+    va_end(va);
+    return retval;
+}
+
+int
+_PyArg_UnpackStack(PyObject **args, Py_ssize_t nargs, const char *name,
+                   Py_ssize_t min, Py_ssize_t max, ...)
+{
+    int retval;
+    va_list vargs;
+
+#ifdef HAVE_STDARG_PROTOTYPES
+    va_start(vargs, max);
+#else
+    va_start(vargs);
+#endif
+    retval = unpack_stack(args, nargs, name, min, max, vargs);
+    va_end(vargs);
+    return retval;
+}
+
 
 /* For type constructors that don't take keyword args
  *
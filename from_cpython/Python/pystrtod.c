@@ -102,7 +102,9 @@ _PyOS_ascii_strtod(const char *nptr, char **endptr)
     errno = 0;
 
     _Py_SET_53BIT_PRECISION_START;
-    result = _Py_dg_strtod(nptr, endptr);
+    // Pyston change: try the fast path first
+    if (!_Py_fast_strtod(nptr, endptr, &result))
+        result = _Py_dg_strtod(nptr, endptr);
     _Py_SET_53BIT_PRECISION_END;
 
     if (*endptr == nptr)
@@ -947,13 +949,22 @@ format_float_short(double d, char format_code,
     char *digits, *digits_end;
     int decpt_as_int, sign, exp_len, exp = 0, use_exp = 0;
     Py_ssize_t decpt, digits_len, vdigits_start, vdigits_end;
+    // Pyston change: _Py_fast_dtoa writes its digits into this buffer.
+    char fast_digits[FAST_DTOA_BUFFER_SIZE];
+    int used_fast_dtoa;
     _Py_SET_53BIT_PRECISION_HEADER;
 
     /* _Py_dg_dtoa returns a digit string (no decimal point or exponent).
        Must be matched by a call to _Py_dg_freedtoa. */
     _Py_SET_53BIT_PRECISION_START;
-    digits = _Py_dg_dtoa(d, mode, precision, &decpt_as_int, &sign,
-                         &digits_end);
+    // Pyston change: try the fast path first
+    used_fast_dtoa = _Py_fast_dtoa(d, mode, (int)precision, fast_digits,
+                                   &decpt_as_int, &sign, &digits_end);
+    if (used_fast_dtoa)
+        digits = fast_digits;
+    else
+        digits = _Py_dg_dtoa(d, mode, precision, &decpt_as_int, &sign,
+                             &digits_end);
     _Py_SET_53BIT_PRECISION_END;
 
     decpt = (Py_ssize_t)decpt_as_int;
@@ -1177,7 +1188,7 @@ format_float_short(double d, char format_code,
            memory that isn't ours. But it's an okay debugging test. */
         assert(p-buf < bufsize);
     }
-    if (digits)
+    if (digits && !used_fast_dtoa)
         _Py_dg_freedtoa(digits);
 
     return buf;
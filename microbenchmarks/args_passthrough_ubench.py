@@ -0,0 +1,14 @@
+# Layers of wrappers that forward their *args and **kwargs unchanged.
+def target(a, b, *args, **kw):
+    return a
+
+def wrap1(*args, **kw):
+    return target(*args, **kw)
+
+def wrap2(*args, **kw):
+    return wrap1(*args, **kw)
+
+def f():
+    for i in xrange(2000000):
+        wrap2(1, 2, 3, x=4, y=5)
+f()
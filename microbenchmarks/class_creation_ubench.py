@@ -0,0 +1,28 @@
+# Creating lots of small subclasses of a common base, like declarative ORM models do at import time.
+class Model(object):
+    def __init__(self, **kw):
+        self.__dict__.update(kw)
+
+    def __repr__(self):
+        return "<%s>" % type(self).__name__
+
+    def __eq__(self, other):
+        return self.__dict__ == other.__dict__
+
+    def __hash__(self):
+        return id(self)
+
+def run():
+    t = 0
+    for i in xrange(20000):
+        class Table(Model):
+            __tablename__ = "table"
+            id = i
+
+            def save(self):
+                pass
+        class Derived(Table):
+            pass
+        t += len(Derived.__mro__)
+    print t
+run()
@@ -0,0 +1,22 @@
+def f():
+    l = range(20)
+    t = tuple("abcdefghij")
+    s = set(range(50))
+    d = dict.fromkeys(["foo", "bar", "baz"])
+    text = "the quick brown fox jumps over the lazy dog"
+    n = 0
+    for i in xrange(1000000):
+        if 15 in l:
+            n += 1
+        if "h" in t:
+            n += 1
+        if i in s:
+            n += 1
+        if "bar" in d:
+            n += 1
+        if "lazy" in text:
+            n += 1
+        if "cat" not in text:
+            n += 1
+    return n
+print f()
@@ -0,0 +1,8 @@
+def f():
+    d = {"count": 0, "total": 0, "name": "x"}
+    for i in xrange(5000000):
+        d["count"] = d["count"] + 1
+        d["total"] += i
+        n = d["name"]
+    return d["count"], d["total"], n
+print f()
@@ -0,0 +1,18 @@
+# Short calls to builtin methods that take their arguments as an array (METH_FASTCALL).
+import heapq
+
+def f():
+    s = "key=value; other=thing"
+    total = 0
+    h = []
+    for i in xrange(1000000):
+        total += s.find("=", 4)
+        total += len(s.split(";", 1))
+        heapq.heappush(h, i & 7)
+        if len(h) > 16:
+            total += heapq.heappop(h)
+    l = range(10)
+    for i in xrange(200000):
+        l.sort(reverse=(i & 1 == 0))
+    print total, l[0]
+f()
@@ -0,0 +1,21 @@
+# Formatting and parsing floats, as done when emitting and reading JSON or CSV.
+# Run it under builds with and without the fast float conversions to compare them.
+
+def f():
+    values = []
+    x = 0.1
+    for i in xrange(1000):
+        values.append(x)
+        values.append(i / 100.0)
+        x = x * 1.37 + 0.5
+        if x > 1e12:
+            x /= 1e12
+
+    total = 0
+    for i in xrange(200):
+        for v in values:
+            s = repr(v)
+            total += len(s) + len(str(v))
+            total += float(s) == v
+    print total
+f()
@@ -0,0 +1,14 @@
+# Builtins from C modules that parse their arguments with PyArg_ParseTuple(AndKeywords).
+import struct
+import binascii
+
+def run():
+    s = struct.Struct("<ii")
+    buf = s.pack(1, 2)
+    t = 0
+    for i in xrange(1000000):
+        t += s.unpack_from(buf, offset=0)[1]
+        t += struct.unpack_from("<ii", buf, 0)[0]
+        t += binascii.crc32(buf, i) & 1
+    print t
+run()
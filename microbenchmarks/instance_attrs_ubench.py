@@ -0,0 +1,16 @@
+# Creating short-lived objects that each get a handful of attributes.
+class Point(object):
+    def __init__(self, x, y, z):
+        self.x = x
+        self.y = y
+        self.z = z
+        self.w = x + y
+        self.v = y + z
+
+def f():
+    t = 0
+    for i in xrange(3000000):
+        p = Point(i, 1, 2)
+        t += p.x + p.w + p.v
+    print t
+f()
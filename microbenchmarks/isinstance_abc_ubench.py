@@ -0,0 +1,19 @@
+# isinstance() checks against ABCs, as done by input validation code.
+import collections
+
+class Record(object):
+    def __len__(self):
+        return 0
+
+def validate(x):
+    return (isinstance(x, collections.Mapping) + isinstance(x, collections.Sequence)
+            + isinstance(x, collections.Sized) + isinstance(x, Record))
+
+def f():
+    objs = [{}, [], Record(), 1, "s"]
+    t = 0
+    for i in xrange(200000):
+        for o in objs:
+            t += validate(o)
+    print t
+f()
@@ -0,0 +1,11 @@
+from collections import namedtuple
+
+NT = namedtuple("NT", "a b c")
+
+def f():
+    t = NT(1, 2, 3)
+    total = 0
+    for i in xrange(3000000):
+        total += t.a + t.b + t.c
+    print total
+f()
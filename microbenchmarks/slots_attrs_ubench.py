@@ -0,0 +1,17 @@
+# Reading and writing attributes of a class that uses __slots__.
+class Vec(object):
+    __slots__ = ("x", "y", "z")
+
+    def __init__(self, x, y, z):
+        self.x = x
+        self.y = y
+        self.z = z
+
+def run():
+    v = Vec(0, 0, 0)
+    for i in xrange(2000000):
+        v.x = v.y + 1
+        v.y = v.z + 1
+        v.z = v.x + 1
+    print v.x, v.y, v.z
+run()
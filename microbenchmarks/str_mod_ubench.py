@@ -0,0 +1,14 @@
+# Formatting log lines and small templates with constant format strings.
+
+def f():
+    total = 0
+    row = {"cls": "row", "id": "r1", "body": "hello world"}
+    for i in xrange(1000000):
+        s = "[%s] %s: request %d took %.3fms" % ("INFO", "server", i, 3.25)
+        total += len(s)
+        s = '<div class="%(cls)s" id="%(id)s">%(body)s</div>' % row
+        total += len(s)
+        s = "%s=%s" % ("key", "value")
+        total += len(s)
+    print total
+f()
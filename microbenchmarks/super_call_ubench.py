@@ -0,0 +1,20 @@
+# Method calls that chain up through super(), as in __init__ methods of class hierarchies.
+class A(object):
+    def f(self, n):
+        return n
+
+class B(A):
+    def f(self, n):
+        return super(B, self).f(n) + 1
+
+class C(B):
+    def f(self, n):
+        return super(C, self).f(n) + 1
+
+def run():
+    c = C()
+    t = 0
+    for i in xrange(2000000):
+        t += c.f(i)
+    print t
+run()
@@ -0,0 +1,16 @@
+# Caches keyed by (str, int, str) tuples, probed several times per key.
+
+def f():
+    cache = {}
+    names = ["user%d" % i for i in range(100)]
+    for i in xrange(100):
+        cache[(names[i], i, "profile")] = i
+    keys = [(names[i], i, "profile") for i in xrange(100)]
+    total = 0
+    for n in xrange(20000):
+        for k in keys:
+            total += cache[k]
+            if k in cache:
+                total += 1
+    print total
+f()
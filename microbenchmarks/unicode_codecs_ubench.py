@@ -0,0 +1,14 @@
+# Decoding request bodies and encoding responses: mostly-ASCII text through the utf-8,
+# ascii and latin-1 codecs.
+
+def f():
+    body = ('{"user": "someone", "items": [1, 2, 3], "note": "caf\xc3\xa9"}' * 40)
+    plain = "GET /index.html HTTP/1.1\r\nHost: example.com\r\n" * 40
+    total = 0
+    for i in xrange(20000):
+        u = body.decode("utf-8")
+        total += len(u.encode("utf-8"))
+        u = plain.decode("ascii")
+        total += len(u.encode("latin-1"))
+    print total
+f()
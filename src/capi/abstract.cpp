@@ -23,6 +23,7 @@
 #include "core/threading.h"
 #include "core/types.h"
 #include "runtime/classobj.h"
+#include "runtime/ics.h"
 #include "runtime/import.h"
 #include "runtime/objmodel.h"
 #include "runtime/types.h"
@@ -127,6 +128,91 @@ static int recursive_isinstance(PyObject* inst, PyObject* cls) noexcept {
     return retval;
 }
 
+// Pyston addition: isinstance() and issubclass() checks against ABCs go through abc.ABCMeta's __instancecheck__ and
+// __subclasscheck__, which are written in Python and slow.  Their answers only change when one of the classes involved
+// is modified, or when a class gets registered with some ABC (which bumps ABCMeta._abc_invalidation_counter and so
+// changes ABCMeta's version tag).  So for metaclasses like ABCMeta we cache the results keyed on the version tags of
+// the checked class, the target class, and the target's metaclass.  Metaclasses opt in to this through
+// __pyston__.setTypecheckCacheable, which abc.py calls for ABCMeta.
+#define TYPECHECK_CACHE_SIZE_EXP 9
+#define TYPECHECK_CACHE_HASH(cls_version, target_version)                                                              \
+    ((((unsigned int)(cls_version)*2654435761u) ^ (unsigned int)(target_version))                                      \
+     & ((1 << TYPECHECK_CACHE_SIZE_EXP) - 1))
+
+struct TypecheckCacheEntry {
+    PY_UINT64_T cls_version;
+    PY_UINT64_T target_version;
+    PY_UINT64_T meta_version;
+    bool valid;
+    bool subclass_check;
+    bool result;
+};
+static TypecheckCacheEntry typecheck_cache[1 << TYPECHECK_CACHE_SIZE_EXP];
+static BoxedClass* cacheable_typecheck_metaclass = NULL;
+
+void setTypecheckCacheable(BoxedClass* metaclass) noexcept {
+    // Only one metaclass at a time; this is just meant for ABCMeta.
+    Py_XDECREF(cacheable_typecheck_metaclass);
+    cacheable_typecheck_metaclass = incref(metaclass);
+    clearTypecheckCache();
+}
+
+void clearTypecheckCache() noexcept {
+    for (auto&& entry : typecheck_cache)
+        entry.valid = false;
+}
+
+bool typecheckOnlyDependsOnVersions(BoxedClass* cls, BoxedClass* target, bool subclass_check) noexcept {
+    // These can return a different __class__ than their type, which isinstance() would look at:
+    if (!subclass_check && (cls->has___class__ || cls->has_getattribute || cls == instance_cls))
+        return false;
+
+    BoxedClass* meta = target->cls;
+    bool has_checker = subclass_check ? meta->has_subclasscheck : meta->has_instancecheck;
+    if (has_checker) {
+        BoxedClass* cacheable = cacheable_typecheck_metaclass;
+        if (!cacheable || !isSubclass(meta, cacheable))
+            return false;
+
+        if (meta != cacheable) {
+            static BoxedString* instancecheck_str = getStaticString("__instancecheck__");
+            static BoxedString* subclasscheck_str = getStaticString("__subclasscheck__");
+            BoxedString* check_str = subclass_check ? subclasscheck_str : instancecheck_str;
+            if (typeLookup(meta, check_str) != typeLookup(cacheable, check_str))
+                return false;
+        }
+    }
+
+    return assign_version_tag(cls) && assign_version_tag(target) && assign_version_tag(meta);
+}
+
+// Returns the cached result of the check, or -1 if there is none.
+static int typecheckCacheLookup(BoxedClass* cls, BoxedClass* target, bool subclass_check) noexcept {
+    if (!typecheckOnlyDependsOnVersions(cls, target, subclass_check))
+        return -1;
+
+    auto&& entry = typecheck_cache[TYPECHECK_CACHE_HASH(cls->tp_version_tag, target->tp_version_tag)];
+    if (entry.valid && entry.cls_version == cls->tp_version_tag && entry.target_version == target->tp_version_tag
+        && entry.meta_version == target->cls->tp_version_tag && entry.subclass_check == subclass_check)
+        return entry.result;
+    return -1;
+}
+
+static void typecheckCacheStore(BoxedClass* cls, BoxedClass* target, bool subclass_check, bool result) noexcept {
+    // Check this again, since the checker might have modified some of the classes (ABCMeta does that to update its
+    // own caches), and we want the new version tags:
+    if (!typecheckOnlyDependsOnVersions(cls, target, subclass_check))
+        return;
+
+    auto&& entry = typecheck_cache[TYPECHECK_CACHE_HASH(cls->tp_version_tag, target->tp_version_tag)];
+    entry.cls_version = cls->tp_version_tag;
+    entry.target_version = target->tp_version_tag;
+    entry.meta_version = target->cls->tp_version_tag;
+    entry.valid = true;
+    entry.subclass_check = subclass_check;
+    entry.result = result;
+}
+
 extern "C" int PyObject_IsInstance(PyObject* inst, PyObject* cls) noexcept {
     STAT_TIMER(t0, "us_timer_pyobject_isinstance", 20);
 
@@ -157,7 +243,15 @@ extern "C" int PyObject_IsInstance(PyObject* inst, PyObject* cls) noexcept {
 
     if (!(PyClass_Check(cls) || PyInstance_Check(cls))) {
         PyObject* checker = NULL;
+        bool cacheable = false;
         if (cls->cls->has_instancecheck) {
+            if (PyType_Check(cls)) {
+                int cached = typecheckCacheLookup(inst->cls, static_cast<BoxedClass*>(cls), false);
+                if (cached != -1)
+                    return cached;
+                cacheable = true;
+            }
+
             checker = _PyObject_LookupSpecial(cls, "__instancecheck__", &name);
             if (!checker && PyErr_Occurred())
                 return -1;
@@ -179,6 +273,8 @@ extern "C" int PyObject_IsInstance(PyObject* inst, PyObject* cls) noexcept {
                 ok = PyObject_IsTrue(res);
                 Py_DECREF(res);
             }
+            if (ok >= 0 && cacheable)
+                typecheckCacheStore(inst->cls, static_cast<BoxedClass*>(cls), false, ok);
             return ok;
         }
     }
@@ -213,7 +309,16 @@ extern "C" int PyObject_IsSubclass(PyObject* derived, PyObject* cls) noexcept {
     }
     if (!(PyClass_Check(cls) || PyInstance_Check(cls))) {
         PyObject* checker = NULL;
+        bool cacheable = false;
         if (cls->cls->has_subclasscheck) {
+            if (PyType_Check(cls) && PyType_Check(derived)) {
+                int cached
+                    = typecheckCacheLookup(static_cast<BoxedClass*>(derived), static_cast<BoxedClass*>(cls), true);
+                if (cached != -1)
+                    return cached;
+                cacheable = true;
+            }
+
             checker = _PyObject_LookupSpecial(cls, "__subclasscheck__", &name);
             if (!checker && PyErr_Occurred())
                 return -1;
@@ -235,6 +340,8 @@ extern "C" int PyObject_IsSubclass(PyObject* derived, PyObject* cls) noexcept {
                 ok = PyObject_IsTrue(res);
                 Py_DECREF(res);
             }
+            if (ok >= 0 && cacheable)
+                typecheckCacheStore(static_cast<BoxedClass*>(derived), static_cast<BoxedClass*>(cls), true, ok);
             return ok;
         } else if (PyErr_Occurred()) {
             return -1;
@@ -261,31 +368,39 @@ extern "C" PyObject* PyObject_GetIter(PyObject* o) noexcept {
 }
 
 
+// Pyston addition: calls the method through a per-caller IC.  args is the result of Py_BuildValue (or NULL for no
+// arguments); the elements of a tuple get passed as separate positional arguments, since the ICs can't handle
+// starargs.
+static PyObject* callMethodFromCaller(PyObject* o, BoxedString* attr, PyObject* args, void* caller_addr) noexcept {
+    if (!args)
+        return callattrFromCapiCaller(o, attr, ArgPassSpec(0), NULL, NULL, NULL, NULL, caller_addr);
+    if (!PyTuple_Check(args))
+        return callattrFromCapiCaller(o, attr, ArgPassSpec(1), args, NULL, NULL, NULL, caller_addr);
+
+    BoxedTuple* t = static_cast<BoxedTuple*>(args);
+    int n = t->size();
+    return callattrFromCapiCaller(o, attr, ArgPassSpec(n), n >= 1 ? t->elts[0] : NULL, n >= 2 ? t->elts[1] : NULL,
+                                  n >= 3 ? t->elts[2] : NULL, n >= 4 ? &t->elts[3] : NULL, caller_addr);
+}
+
 extern "C" PyObject* PyObject_CallMethod(PyObject* o, const char* name, const char* format, ...) noexcept {
     va_list va;
     PyObject* args = NULL;
-    PyObject* retval = NULL;
 
     if (o == NULL || name == NULL)
         return null_error();
 
-    ArgPassSpec argspec(0, 0, true, false);
     if (format && *format) {
         va_start(va, format);
         args = Py_VaBuildValue(format, va);
         va_end(va);
 
-        if (!PyTuple_Check(args))
-            argspec = ArgPassSpec(1);
-    } else
-        argspec = ArgPassSpec(0);
+        if (args == NULL)
+            return NULL;
+    }
     AUTO_XDECREF(args);
-    retval = callattrInternal<ExceptionStyle::CAPI, NOT_REWRITABLE>(
-        o, autoDecref(internStringMortal(name)), CLASS_OR_INST, NULL, argspec, args, NULL, NULL, NULL, NULL);
-    if (!retval && !PyErr_Occurred())
-        PyErr_SetString(PyExc_AttributeError, name);
-
-    return retval;
+    return callMethodFromCaller(o, autoDecref(internStringMortal(name)), args,
+                                __builtin_extract_return_addr(__builtin_return_address(0)));
 }
 
 extern "C" PyObject* PyObject_CallMethodObjArgs(PyObject* callable, PyObject* name, ...) noexcept {
@@ -319,12 +434,7 @@ extern "C" PyObject* PyObject_CallMethodObjArgs(PyObject* callable, PyObject* na
     Py_INCREF(attr);
     internStringMortalInplace(attr);
     AUTO_DECREF(attr);
-    tmp = callattrInternal<ExceptionStyle::CAPI, NOT_REWRITABLE>(
-        callable, attr, CLASS_OR_INST, NULL, ArgPassSpec(0, 0, true, false), args, NULL, NULL, NULL, NULL);
-    if (!tmp && !PyErr_Occurred())
-        PyErr_Format(PyExc_AttributeError, "'%.50s' object has no attribute '%.400s'", callable->cls->tp_name,
-                     PyString_AS_STRING(attr));
-
+    tmp = callMethodFromCaller(callable, attr, args, __builtin_extract_return_addr(__builtin_return_address(0)));
 
     Py_DECREF(args);
 
@@ -333,31 +443,24 @@ extern "C" PyObject* PyObject_CallMethodObjArgs(PyObject* callable, PyObject* na
 
 
 extern "C" PyObject* _PyObject_CallMethod_SizeT(PyObject* o, const char* name, const char* format, ...) noexcept {
-    PyObject* args = NULL, *tmp;
+    PyObject* args = NULL;
     va_list vargs;
 
     if (o == NULL || name == NULL)
         return null_error();
 
-    ArgPassSpec argspec(0, 0, true, false);
-
     /* count the args */
     if (format && *format) {
         va_start(vargs, format);
         args = _Py_VaBuildValue_SizeT(format, vargs);
         va_end(vargs);
 
-        if (!PyTuple_Check(args))
-            argspec = ArgPassSpec(1);
-    } else
-        argspec = ArgPassSpec(0);
+        if (args == NULL)
+            return NULL;
+    }
     AUTO_XDECREF(args);
 
-    tmp = callattrInternal<ExceptionStyle::CAPI, NOT_REWRITABLE>(o, autoDecref(internStringMortal(name)), CLASS_OR_INST,
-                                                                 NULL, argspec, args, NULL, NULL, NULL, NULL);
-    if (!tmp && !PyErr_Occurred())
-        PyErr_Format(PyExc_AttributeError, "'%.50s' object has no attribute '%.400s'", o->cls->tp_name, name);
-
-    return tmp;
+    return callMethodFromCaller(o, autoDecref(internStringMortal(name)), args,
+                                __builtin_extract_return_addr(__builtin_return_address(0)));
 }
 }
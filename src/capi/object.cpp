@@ -20,6 +20,7 @@
 #include "capi/types.h"
 #include "core/threading.h"
 #include "core/types.h"
+#include "runtime/ics.h"
 #include "runtime/import.h"
 #include "runtime/objmodel.h"
 #include "runtime/types.h"
@@ -554,15 +555,9 @@ extern "C" int PyObject_SetAttrString(PyObject* v, const char* name, PyObject* w
 }
 
 extern "C" PyObject* PyObject_GetAttrString(PyObject* o, const char* attr) noexcept {
-    try {
-        Box* r = getattrInternal<ExceptionStyle::CXX>(o, autoDecref(internStringMortal(attr)));
-        if (!r)
-            PyErr_Format(PyExc_AttributeError, "'%.50s' object has no attribute '%.400s'", o->cls->tp_name, attr);
-        return r;
-    } catch (ExcInfo e) {
-        setCAPIException(e);
-        return NULL;
-    }
+    BoxedString* s = internStringMortal(attr);
+    AUTO_DECREF(s);
+    return getattrFromCapiCaller(o, s, __builtin_extract_return_addr(__builtin_return_address(0)));
 }
 
 extern "C" int PyObject_HasAttr(PyObject* v, PyObject* name) noexcept {
@@ -2061,12 +2061,84 @@ bool update_slot(BoxedClass* type, llvm::StringRef attr) noexcept {
     return true;
 }
 
+// Pyston addition: when a new class has a single base class, a slot whose dunder names the class doesn't define
+// itself will resolve to exactly what it resolved to on the base, since every typeLookup will find the same thing.
+// We only trust heap types as templates, since their slots were all computed by update_one_slot (and kept up to date
+// by update_slot), while the slots of builtin and extension types can differ from what update_one_slot would compute.
+static BoxedClass* slotTemplateBase(BoxedClass* type) noexcept {
+    if (!(type->tp_flags & Py_TPFLAGS_HEAPTYPE))
+        return NULL;
+
+    BoxedClass* base = type->tp_base;
+    if (!base || !(base->tp_flags & Py_TPFLAGS_HEAPTYPE))
+        return NULL;
+
+    if (!type->tp_bases || PyTuple_GET_SIZE(type->tp_bases) != 1 || PyTuple_GET_ITEM(type->tp_bases, 0) != base)
+        return NULL;
+
+    // A metaclass can override mro(), so check that the mro is the one we'd get from the base:
+    PyObject* mro = type->tp_mro;
+    PyObject* base_mro = base->tp_mro;
+    if (!mro || !base_mro || PyTuple_GET_SIZE(mro) != PyTuple_GET_SIZE(base_mro) + 1
+        || PyTuple_GET_ITEM(mro, 0) != type)
+        return NULL;
+    for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(base_mro); i++) {
+        if (PyTuple_GET_ITEM(mro, i + 1) != PyTuple_GET_ITEM(base_mro, i))
+            return NULL;
+    }
+
+    return base;
+}
+
+// Copies the slot for the slotdefs starting at p from the base class, if type doesn't define any of their names.
+// Returns the slotdef after the ones it handled, or NULL if update_one_slot needs to compute the slot.
+static const slotdef* inherit_one_slot(BoxedClass* type, BoxedClass* base, const slotdef* p) noexcept {
+    int offset = p->offset;
+    const slotdef* end = p;
+    do {
+        assert(end->name_strobj->cls == str_cls);
+        if (type->getattr(static_cast<BoxedString*>(end->name_strobj)))
+            return NULL;
+    } while ((++end)->offset == offset);
+
+    void** ptr = slotptr(type, offset);
+    if (ptr == NULL)
+        return end;
+
+    void** base_ptr = slotptr(base, offset);
+    assert(base_ptr);
+
+    if (p->flags & PyWrapperFlag_BOOL) {
+        *(bool*)ptr = *(bool*)base_ptr;
+    } else {
+        *ptr = *base_ptr;
+        if (offset == offsetof(BoxedClass, tp_descr_get))
+            type->tpp_descr_get = base->tpp_descr_get;
+    }
+    return end;
+}
+
 void fixup_slot_dispatchers(BoxedClass* self) noexcept {
     init_slotdefs();
 
+    static StatCounter num_inherited("num_slots_inherited_from_template");
+    static StatCounter num_updated("num_slots_updated");
+
+    BoxedClass* template_base = slotTemplateBase(self);
+
     const slotdef* p = slotdefs;
-    while (p->name)
+    while (p->name) {
+        if (template_base) {
+            const slotdef* next = inherit_one_slot(self, template_base, p);
+            if (next) {
+                num_inherited.log();
+                p = next;
+                continue;
+            }
+        }
+        num_updated.log();
         p = update_one_slot(self, p);
+    }
 }
 
 void fixup_pyston_slot_dispatchers(BoxedClass* self) noexcept {
@@ -2600,6 +2672,25 @@ static PyObject* mro_implementation(PyTypeObject* type) noexcept {
     assert(type->tp_bases->cls == tuple_cls);
     n = PyTuple_GET_SIZE(bases);
 
+    // Pyston change: with a single base class, the C3 merge always produces the class followed by the mro of its
+    // base, so skip building and merging the intermediate lists.
+    if (n == 1 && PyType_Check(PyTuple_GET_ITEM(bases, 0)) && ((PyTypeObject*)PyTuple_GET_ITEM(bases, 0))->tp_mro) {
+        PyObject* parentMRO = ((PyTypeObject*)PyTuple_GET_ITEM(bases, 0))->tp_mro;
+        assert(PyTuple_Check(parentMRO));
+        Py_ssize_t len = PyTuple_GET_SIZE(parentMRO);
+        result = PyList_New(len + 1);
+        if (result == NULL)
+            return NULL;
+        Py_INCREF(type);
+        PyList_SET_ITEM(result, 0, (PyObject*)type);
+        for (i = 0; i < len; i++) {
+            PyObject* b = PyTuple_GET_ITEM(parentMRO, i);
+            Py_INCREF(b);
+            PyList_SET_ITEM(result, i + 1, b);
+        }
+        return result;
+    }
+
     to_merge = PyList_New(n + 1);
     if (to_merge == NULL)
         return NULL;
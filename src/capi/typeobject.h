@@ -64,6 +64,16 @@ Box* slotTpGetattrHookInternal(Box* self, BoxedString* attr, GetattrRewriteArgs*
 Box* proxyToTppCall(Box* self, Box* args, Box* kw) noexcept;
 
 int add_methods(PyTypeObject* type, PyMethodDef* meth) noexcept;
+
+// Makes sure type has a valid tp_version_tag; returns 0 if that's not possible.  Defined in objmodel.cpp.
+int assign_version_tag(PyTypeObject* type) noexcept;
+
+// isinstance()/issubclass() result caching, see abstract.cpp.
+// Returns whether isinstance() of instances of cls (or issubclass() of cls, if subclass_check is set) against target
+// is determined by the version tags of cls, target and target's metaclass, and if so makes sure those tags are valid.
+bool typecheckOnlyDependsOnVersions(BoxedClass* cls, BoxedClass* target, bool subclass_check) noexcept;
+void setTypecheckCacheable(BoxedClass* metaclass) noexcept;
+void clearTypecheckCache() noexcept;
 }
 
 #endif
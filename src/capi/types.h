@@ -102,6 +102,18 @@ static_assert(offsetof(BoxedCApiFunction, method_def) == offsetof(PyCFunctionObj
 static_assert(offsetof(BoxedCApiFunction, passthrough) == offsetof(PyCFunctionObject, m_self), "");
 static_assert(offsetof(BoxedCApiFunction, module) == offsetof(PyCFunctionObject, m_module), "");
 
+// Calls a METH_FASTCALL function with the arguments of a call that doesn't use * or **, without building an
+// argument tuple.  The first `skip` positional arguments are not passed on (method descriptors receive self as
+// their first argument and pass it as `self` instead).  If rewrite_args is given, the IC calls the function
+// directly as well.
+template <ExceptionStyle S>
+Box* callFastCallFunction(PyMethodDef* method_def, Box* self, RewriterVar* r_self, CallRewriteArgs* rewrite_args,
+                          ArgPassSpec argspec, int skip, Box* arg1, Box* arg2, Box* arg3, Box** args,
+                          const std::vector<BoxedString*>* keyword_names) noexcept(S == CAPI);
+// Calls a METH_FASTCALL function given its arguments as a tuple and (possibly NULL) dict.
+Box* callFastCallFunctionFromTuple(PyMethodDef* method_def, Box* self, BoxedTuple* varargs,
+                                   BoxedDict* kwargs) noexcept;
+
 PyObject* try_3way_to_rich_compare(PyObject* v, PyObject* w, int op) noexcept;
 PyObject* convert_3way_to_object(int op, int c) noexcept;
 int default_3way_compare(PyObject* v, PyObject* w);
@@ -41,6 +41,7 @@
 #include "runtime/inline/list.h"
 #include "runtime/long.h"
 #include "runtime/objmodel.h"
+#include "runtime/rewrite_args.h"
 #include "runtime/set.h"
 #include "runtime/types.h"
 #include "runtime/util.h"
@@ -78,6 +79,7 @@ private:
 
     Value createFunction(BST_MakeFunction* node, BoxedCode* node_code);
     Value doBinOp(BST_stmt* node, Value left, Value right, int op, BinExpType exp_type);
+    Value doAdd(BST_stmt_with_dest* node, STOLEN(Value) left, Value right, BinExpType exp_type);
     void doStore(int vreg, STOLEN(Value) value);
     void doStoreArg(BST_Name* name, STOLEN(Value) value);
     Box* doOSR(BST_Jump* node);
@@ -482,6 +484,47 @@ Value ASTInterpreter::doBinOp(BST_stmt* node, Value left, Value right, int op, B
     }
 }
 
+// If the result of node gets assigned straight to a local variable, as in `x = x + y` or `x += y`, returns the vreg
+// of that variable.
+static int getAssignedLocalVReg(BST_stmt_with_dest* node) {
+    BST_stmt* next;
+    if (node->is_invoke())
+        next = node->get_normal_block()->body();
+    else
+        next = (BST_stmt*)&((unsigned char*)node)[node->size_in_bytes()];
+
+    if (!next || next->type() != BST_TYPE::StoreName)
+        return VREG_UNDEFINED;
+    BST_StoreName* store = bst_cast<BST_StoreName>(next);
+    if (store->lookup_type != ScopeInfo::VarScopeType::FAST || store->vreg_value != node->vreg_dst)
+        return VREG_UNDEFINED;
+    return store->vreg;
+}
+
+Value ASTInterpreter::doAdd(BST_stmt_with_dest* node, STOLEN(Value) left, Value right, BinExpType exp_type) {
+    assert(exp_type == BinExpType::AugBinOp || exp_type == BinExpType::BinOp);
+
+    // Building up a string with `s += x` in a loop would be quadratic if every step copied the string, so when the
+    // left operand is a string that is about to be overwritten by the result, let concatInPlaceHelper() try to
+    // append to it in place.  The JIT emits it as an IC: str + str sites call concatStrInPlaceHelper() directly, the
+    // others get the usual binop IC.
+    //
+    // The baseline JIT keeps variables that aren't live past the end of the block in registers instead of the vregs
+    // array, and the refcount of a string held there doesn't tell whether another such variable refers to it too;
+    // concatStrInPlaceHelper() only finds the variable in the vregs array, so those always get a copy.
+    int vreg = left.o->cls == str_cls ? getAssignedLocalVReg(node) : VREG_UNDEFINED;
+    if (vreg == VREG_UNDEFINED || vregs[vreg] != left.o) {
+        AUTO_DECREF(left.o);
+        return doBinOp(node, left, right, AST_TYPE::Add, exp_type);
+    }
+
+    bool is_augbinop = exp_type == BinExpType::AugBinOp;
+    RewriterVar* v = NULL;
+    if (jit)
+        v = jit->emitConcatInPlace(node, vreg, left, right, is_augbinop);
+    return Value(ASTInterpreterJitInterface::concatInPlaceHelper(this, vreg, left.o, right.o, is_augbinop), v);
+}
+
 void ASTInterpreter::doStore(int vreg, STOLEN(Value) value) {
     if (vreg == VREG_UNDEFINED) {
         Py_DECREF(value.o);
@@ -566,9 +609,11 @@ void ASTInterpreter::visit_unpackintoarray(BST_UnpackIntoArray* node) {
 
 Value ASTInterpreter::visit_binop(BST_BinOp* node) {
     Value left = getVReg(node->vreg_left);
-    AUTO_DECREF(left.o);
     Value right = getVReg(node->vreg_right);
     AUTO_DECREF(right.o);
+    if (node->op_type == AST_TYPE::Add)
+        return doAdd(node, left, right, BinExpType::BinOp);
+    AUTO_DECREF(left.o);
     return doBinOp(node, left, right, node->op_type, BinExpType::BinOp);
 }
 
@@ -799,9 +844,11 @@ Value ASTInterpreter::visit_augBinOp(BST_AugBinOp* node) {
     assert(node->op_type != AST_TYPE::Is && node->op_type != AST_TYPE::IsNot && "not tested yet");
 
     Value left = getVReg(node->vreg_left);
-    AUTO_DECREF(left.o);
     Value right = getVReg(node->vreg_right);
     AUTO_DECREF(right.o);
+    if (node->op_type == AST_TYPE::Add)
+        return doAdd(node, left, right, BinExpType::AugBinOp);
+    AUTO_DECREF(left.o);
     return doBinOp(node, left, right, node->op_type, BinExpType::AugBinOp);
 }
 
@@ -1841,6 +1888,71 @@ int ASTInterpreterJitInterface::getGlobalsOffset() {
     return offsetof(ASTInterpreter, frame_info.globals);
 }
 
+Box* ASTInterpreterJitInterface::concatInPlaceHelper(void* _interpreter, int vreg, STOLEN(Box*) lhs, Box* rhs,
+                                                     bool is_augbinop) {
+    std::unique_ptr<Rewriter> rewriter(
+        Rewriter::createRewriter(__builtin_extract_return_addr(__builtin_return_address(0)), 5, "concatInPlace"));
+
+    if (lhs->cls == str_cls && rhs->cls == str_cls) {
+        if (rewriter.get()) {
+            RewriterVar* r_lhs = rewriter->getArg(2)->setType(RefType::OWNED);
+            RewriterVar* r_rhs = rewriter->getArg(3)->setType(RefType::BORROWED);
+            r_lhs->addAttrGuard(offsetof(Box, cls), (intptr_t)str_cls);
+            r_rhs->addAttrGuard(offsetof(Box, cls), (intptr_t)str_cls);
+            RewriterVar* r_rtn
+                = rewriter->call(true, (void*)concatStrInPlaceHelper, rewriter->getArg(0), rewriter->loadConst(vreg),
+                                 r_lhs, r_rhs)->setType(RefType::OWNED);
+            r_lhs->refConsumed();
+            rewriter->commitReturning(r_rtn);
+        }
+        return concatStrInPlaceHelper(_interpreter, vreg, lhs, rhs);
+    }
+
+    // Anything else is a normal addition, and gets the same IC as binop() / augbinop() would.
+    AUTO_DECREF(lhs);
+    Box* rtn;
+    if (rewriter.get()) {
+        BinopRewriteArgs rewrite_args(rewriter.get(), rewriter->getArg(2)->setType(RefType::OWNED),
+                                      rewriter->getArg(3)->setType(RefType::BORROWED),
+                                      rewriter->getReturnDestination());
+        if (is_augbinop)
+            rtn = binopInternal<REWRITABLE, true /*inplace*/>(lhs, rhs, AST_TYPE::Add, &rewrite_args);
+        else
+            rtn = binopInternal<REWRITABLE, false /*not inplace*/>(lhs, rhs, AST_TYPE::Add, &rewrite_args);
+        if (rewrite_args.out_success)
+            rewriter->commitReturning(rewrite_args.out_rtn);
+    } else {
+        if (is_augbinop)
+            rtn = binopInternal<NOT_REWRITABLE, true /*inplace*/>(lhs, rhs, AST_TYPE::Add, NULL);
+        else
+            rtn = binopInternal<NOT_REWRITABLE, false /*not inplace*/>(lhs, rhs, AST_TYPE::Add, NULL);
+    }
+    return rtn;
+}
+
+Box* ASTInterpreterJitInterface::concatStrInPlaceHelper(void* _interpreter, int vreg, STOLEN(Box*) _lhs, Box* _rhs) {
+    ASTInterpreter* interpreter = (ASTInterpreter*)_interpreter;
+    Box** slot = &interpreter->vregs[vreg];
+    BoxedString* lhs = static_cast<BoxedString*>(_lhs);
+    BoxedString* rhs = static_cast<BoxedString*>(_rhs);
+    assert(lhs->cls == str_cls && rhs->cls == str_cls);
+
+    // If the only references to the string are the ones held by the variable and by us, nobody can observe it getting
+    // modified.  The variable gets overwritten with the result right after this, so store the resized string into it
+    // already; that keeps the vreg pointing to a valid object even if the string has to be moved.
+    if (*slot == lhs && lhs->ob_refcnt == 2 && lhs != rhs && !PyString_CHECK_INTERNED(lhs)) {
+        Py_DECREF(lhs);
+        BoxedString* rtn = strAppendInPlace(lhs, rhs);
+        if (!rtn)
+            throwCAPIException();
+        *slot = rtn;
+        return incref(rtn);
+    }
+
+    AUTO_DECREF(lhs);
+    return new (lhs->size() + rhs->size()) BoxedString(lhs->s(), rhs->s());
+}
+
 void ASTInterpreterJitInterface::delNameHelper(void* _interpreter, InternedString name) {
     ASTInterpreter* interpreter = (ASTInterpreter*)_interpreter;
     Box* boxed_locals = interpreter->frame_info.boxedLocals;
@@ -1851,9 +1963,12 @@ void ASTInterpreterJitInterface::delNameHelper(void* _interpreter, InternedStrin
         if (it == d.end()) {
             assertNameDefined(0, name.c_str(), NameError, false /* local_var_msg */);
         }
-        Py_DECREF(it->first.value);
-        Py_DECREF(it->second);
+        Box* key = it->first.value;
+        Box* value = it->second;
         d.erase(it);
+        static_cast<BoxedDict*>(boxed_locals)->keysChanged();
+        Py_DECREF(key);
+        Py_DECREF(value);
     } else if (boxed_locals->cls == attrwrapper_cls) {
         attrwrapperDel(boxed_locals, name);
     } else {
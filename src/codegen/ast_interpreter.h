@@ -44,6 +44,8 @@ struct ASTInterpreterJitInterface {
     static int getGeneratorOffset();
     static int getGlobalsOffset();
 
+    static Box* concatInPlaceHelper(void* interp, int vreg, STOLEN(Box*) lhs, Box* rhs, bool is_augbinop);
+    static Box* concatStrInPlaceHelper(void* interp, int vreg, STOLEN(Box*) lhs, Box* rhs);
     static void delNameHelper(void* _interpreter, InternedString name);
     static Box* derefHelper(void* interp, BST_LoadName* node);
     static Box* landingpadHelper(void* interp);
@@ -307,6 +307,15 @@ RewriterVar* JitFragmentWriter::emitCompare(BST_stmt* node, RewriterVar* lhs, Re
         .first->setType(RefType::OWNED);
 }
 
+RewriterVar* JitFragmentWriter::emitConcatInPlace(BST_stmt* node, int vreg, STOLEN(RewriterVar*) lhs, RewriterVar* rhs,
+                                                  bool is_augbinop) {
+    auto rtn = emitPPCall((void*)ASTInterpreterJitInterface::concatInPlaceHelper,
+                          { getInterp(), imm(vreg), lhs, rhs, imm(is_augbinop) }, 2 * 320, true /* record type */,
+                          node);
+    lhs->refConsumed(rtn.second);
+    return rtn.first->setType(RefType::OWNED);
+}
+
 RewriterVar* JitFragmentWriter::emitCreateDict() {
     return call(false, (void*)createDict)->setType(RefType::OWNED);
 }
@@ -272,6 +272,8 @@ public:
     RewriterVar* emitCallattr(BST_stmt* node, RewriterVar* obj, BoxedString* attr, CallattrFlags flags,
                               const llvm::ArrayRef<RewriterVar*> args, const std::vector<BoxedString*>* keyword_names);
     RewriterVar* emitCompare(BST_stmt* node, RewriterVar* lhs, RewriterVar* rhs, int op_type);
+    RewriterVar* emitConcatInPlace(BST_stmt* node, int vreg, STOLEN(RewriterVar*) lhs, RewriterVar* rhs,
+                                   bool is_augbinop);
     RewriterVar* emitCreateDict();
     void emitDictSet(RewriterVar* dict, RewriterVar* k, RewriterVar* v);
     RewriterVar* emitCreateList(const llvm::ArrayRef<STOLEN(RewriterVar*)> values);
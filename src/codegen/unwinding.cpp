@@ -944,6 +944,7 @@ DeoptState getDeoptState() {
                 if (e)
                     d->d[boxInt(p.first)] = readEntry(e);
             }
+            d->keysChanged();
         } else {
             abort();
         }
@@ -975,6 +976,7 @@ static BoxedDict* localsForFrame(Box** vregs, CFG* cfg) {
             rtn->d[incref(vregs_sym_map[vreg].getBox())] = incref(val);
         }
     }
+    rtn->keysChanged();
     return rtn;
 }
 
@@ -148,6 +148,7 @@ class BoxedClass;
 class BoxedModule;
 class BoxedFunctionBase;
 class BoxedCode;
+class BoxedString;
 
 class ICGetattr;
 struct ICSlotInfo;
@@ -234,6 +235,16 @@ struct ParamNames {
     unsigned char has_vararg_name : 1;
     unsigned char has_kwarg_name : 1;
 
+    // Caches how the keywords of a call site bind to these parameters, so that calls that don't get rewritten
+    // don't have to match up the names on every call.  dests[i] is the index of the parameter that
+    // keyword_names[i] binds to, or -1 if it doesn't name one.  Only keyword names that are immortal interned
+    // strings are cached, so that they can be compared by pointer.  See getKeywordBinding() in objmodel.cpp.
+    struct KeywordBinding {
+        std::vector<BoxedString*> keyword_names;
+        std::vector<int> dests;
+    };
+    mutable std::vector<KeywordBinding> keyword_bindings;
+
     ParamNames(ParamNames&) = delete;
     ParamNames(ParamNames&&) = default;
     ~ParamNames();
@@ -691,6 +702,10 @@ inline void internStringMortalInplace(BoxedString*& s) noexcept {
 struct HCAttrs {
 public:
     struct AttrList {
+        // Nonzero if this array lives inside its object (after the end of the instance, see PyType_GenericAlloc)
+        // rather than in its own allocation, in which case this is the number of slots available there.
+        // Separately-allocated arrays have their capacity implied by the number of attributes.
+        intptr_t inline_capacity;
         Box* attrs[0];
     };
 
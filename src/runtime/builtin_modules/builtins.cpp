@@ -505,6 +505,73 @@ Box* issubclass_func(Box* child, Box* parent) {
     return boxBool(rtn);
 }
 
+static void guardVersionTag(RewriterVar* r_cls, BoxedClass* cls) {
+    static_assert(sizeof(BoxedClass::tp_flags) == 8, "addAttrGuard only supports 64bit values");
+    static_assert(sizeof(BoxedClass::tp_version_tag) == 8, "addAttrGuard only supports 64bit values");
+    r_cls->addGuard((intptr_t)cls);
+    r_cls->addAttrGuard(offsetof(BoxedClass, tp_flags), (intptr_t)cls->tp_flags);
+    r_cls->addAttrGuard(offsetof(BoxedClass, tp_version_tag), (intptr_t)cls->tp_version_tag);
+}
+
+static Box* isinstanceCapi(Box* obj, Box* cls) noexcept {
+    int rtn = PyObject_IsInstance(obj, cls);
+    if (rtn < 0)
+        return NULL;
+    return boxBool(rtn);
+}
+
+static Box* issubclassCapi(Box* child, Box* parent) noexcept {
+    int rtn = PyObject_IsSubclass(child, parent);
+    if (rtn < 0)
+        return NULL;
+    return boxBool(rtn);
+}
+
+// isinstance() and issubclass() calls get folded to a constant if their answer only depends on the classes involved
+// (see typecheckOnlyDependsOnVersions), behind guards on the version tags of those classes.  The others get rewritten
+// to a direct call.
+template <bool subclass_check, ExceptionStyle S>
+static Box* typecheckCallInternal(BoxedFunctionBase* func, CallRewriteArgs* rewrite_args, ArgPassSpec argspec,
+                                  Box* arg1, Box* arg2, Box* arg3, Box** args,
+                                  const std::vector<BoxedString*>* keyword_names) noexcept(S == CAPI) {
+    if (argspec != ArgPassSpec(2) || !rewrite_args || !PyType_Check(arg2)
+        || (subclass_check && !PyType_Check(arg1)))
+        return callFunc<S>(func, rewrite_args, argspec, arg1, arg2, arg3, args, keyword_names);
+
+    BoxedClass* cls = subclass_check ? static_cast<BoxedClass*>(arg1) : arg1->cls;
+    BoxedClass* target = static_cast<BoxedClass*>(arg2);
+
+    Box* rtn = subclass_check ? issubclassCapi(arg1, arg2) : isinstanceCapi(arg1, arg2);
+    if (!rtn) {
+        if (S == CXX)
+            throwCAPIException();
+        return NULL;
+    }
+
+    // Checked after the call, since calling __instancecheck__ or __subclasscheck__ can modify the classes:
+    if (typecheckOnlyDependsOnVersions(cls, target, subclass_check)) {
+        static StatCounter num_folded("num_typecheck_folded");
+        num_folded.log();
+
+        RewriterVar* r_cls = subclass_check ? rewrite_args->arg1 : rewrite_args->arg1->getAttr(offsetof(Box, cls));
+        guardVersionTag(r_cls, cls);
+        guardVersionTag(rewrite_args->arg2, target);
+        guardVersionTag(rewrite_args->arg2->getAttr(offsetof(Box, cls)), target->cls);
+
+        rewrite_args->out_rtn = rewrite_args->rewriter->loadConst((intptr_t)rtn)->setType(RefType::BORROWED);
+    } else {
+        rewrite_args->arg2->addGuard((intptr_t)arg2);
+        RewriterVar* r_rtn
+            = rewrite_args->rewriter->call(true, subclass_check ? (void*)issubclassCapi : (void*)isinstanceCapi,
+                                           rewrite_args->arg1, rewrite_args->arg2)->setType(RefType::OWNED);
+        if (S == CXX)
+            rewrite_args->rewriter->checkAndThrowCAPIException(r_rtn);
+        rewrite_args->out_rtn = r_rtn;
+    }
+    rewrite_args->out_success = true;
+    return rtn;
+}
+
 Box* intern_func(Box* str) {
     if (!PyString_CheckExact(str)) // have to use exact check!
         raiseExcHelper(TypeError, "can't intern subclass of string");
@@ -2480,12 +2547,16 @@ void setupBuiltins() {
         "pow", new BoxedBuiltinFunctionOrMethod(
                    BoxedCode::create((void*)powFunc, UNKNOWN, 3, false, false, "pow", pow_doc), { Py_None }, NULL));
 
-    Box* isinstance_obj = new BoxedBuiltinFunctionOrMethod(
-        BoxedCode::create((void*)isinstance_func, BOXED_BOOL, 2, "isinstance", isinstance_doc));
+    auto isinstance_code = BoxedCode::create((void*)isinstance_func, BOXED_BOOL, 2, "isinstance", isinstance_doc);
+    isinstance_code->internal_callable.capi_val = typecheckCallInternal<false, CAPI>;
+    isinstance_code->internal_callable.cxx_val = typecheckCallInternal<false, CXX>;
+    Box* isinstance_obj = new BoxedBuiltinFunctionOrMethod(isinstance_code);
     builtins_module->giveAttr("isinstance", isinstance_obj);
 
-    Box* issubclass_obj = new BoxedBuiltinFunctionOrMethod(
-        BoxedCode::create((void*)issubclass_func, BOXED_BOOL, 2, "issubclass", issubclass_doc));
+    auto issubclass_code = BoxedCode::create((void*)issubclass_func, BOXED_BOOL, 2, "issubclass", issubclass_doc);
+    issubclass_code->internal_callable.capi_val = typecheckCallInternal<true, CAPI>;
+    issubclass_code->internal_callable.cxx_val = typecheckCallInternal<true, CXX>;
+    Box* issubclass_obj = new BoxedBuiltinFunctionOrMethod(issubclass_code);
     builtins_module->giveAttr("issubclass", issubclass_obj);
 
     Box* intern_obj
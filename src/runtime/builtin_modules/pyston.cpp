@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "capi/typeobject.h"
 #include "codegen/parser.h"
 #include "core/types.h"
 #include "runtime/objmodel.h"
@@ -76,6 +77,14 @@ static Box* pyCompile(Box* fname, Box* force) {
     Py_RETURN_NONE;
 }
 
+static Box* setTypecheckCacheableFunc(Box* metaclass) {
+    if (!PyType_Check(metaclass) || !isSubclass(static_cast<BoxedClass*>(metaclass), type_cls))
+        raiseExcHelper(TypeError, "setTypecheckCacheable takes a metaclass");
+
+    setTypecheckCacheable(static_cast<BoxedClass*>(metaclass));
+    Py_RETURN_NONE;
+}
+
 void setupPyston() {
     pyston_module = createModule(autoDecref(boxString("__pyston__")));
 
@@ -90,5 +99,9 @@ void setupPyston() {
 
     pyston_module->giveAttr(
         "py_compile", new BoxedBuiltinFunctionOrMethod(BoxedCode::create((void*)pyCompile, UNKNOWN, 2, "pyCompile")));
+
+    pyston_module->giveAttr("setTypecheckCacheable",
+                            new BoxedBuiltinFunctionOrMethod(BoxedCode::create((void*)setTypecheckCacheableFunc, NONE,
+                                                                               1, "setTypecheckCacheable")));
 }
 }
@@ -41,10 +41,12 @@
 #include "core/threading.h"
 #include "core/types.h"
 #include "runtime/classobj.h"
+#include "runtime/ics.h"
 #include "runtime/import.h"
 #include "runtime/objmodel.h"
 #include "runtime/rewrite_args.h"
 #include "runtime/types.h"
+#include "runtime/util.h"
 
 namespace pyston {
 
@@ -76,14 +78,7 @@ extern "C" PyObject* PyObject_GetAttr(PyObject* o, PyObject* attr) noexcept {
     internStringMortalInplace(s);
     AUTO_DECREF(s);
 
-    Box* r = getattrInternal<ExceptionStyle::CAPI>(o, s);
-
-    if (!r && !PyErr_Occurred()) {
-        PyErr_Format(PyExc_AttributeError, "'%.50s' object has no attribute '%.400s'", o->cls->tp_name,
-                     PyString_AS_STRING(attr));
-    }
-
-    return r;
+    return getattrFromCapiCaller(o, s, __builtin_extract_return_addr(__builtin_return_address(0)));
 }
 
 extern "C" PyObject* PyObject_GenericGetAttr(PyObject* o, PyObject* name) noexcept {
@@ -1386,6 +1381,131 @@ extern "C" char* PyModule_GetFilename(PyObject* m) noexcept {
     return PyString_AsString(fileobj);
 }
 
+template <ExceptionStyle S>
+Box* callFastCallFunction(PyMethodDef* method_def, Box* self, RewriterVar* r_self, CallRewriteArgs* rewrite_args,
+                          ArgPassSpec argspec, int skip, Box* arg1, Box* arg2, Box* arg3, Box** args,
+                          const std::vector<BoxedString*>* keyword_names) noexcept(S == CAPI) {
+    int flags = method_def->ml_flags & ~(METH_CLASS | METH_STATIC | METH_COEXIST);
+    assert(flags & METH_FASTCALL);
+    assert(!argspec.has_starargs && !argspec.has_kwargs);
+    assert(!argspec.num_keywords || (flags & METH_KEYWORDS));
+    assert(argspec.num_args >= skip);
+
+    int nargs = argspec.num_args - skip;
+    int nstack = nargs + argspec.num_keywords;
+
+    // Our calling convention already passes the positional arguments followed by the keyword values,
+    // so all we have to do is gather arg1-arg3 and args into one array.
+    Box** stack = NULL;
+    if (nstack) {
+        stack = (Box**)alloca(nstack * sizeof(Box*));
+        for (int i = 0; i < nstack; i++)
+            stack[i] = getArg(i + skip, arg1, arg2, arg3, args);
+    }
+
+    BoxedTuple* kwnames = NULL;
+    if (argspec.num_keywords)
+        kwnames = BoxedTuple::create(keyword_names->size(), (Box**)keyword_names->data());
+    AUTO_XDECREF(kwnames);
+
+    if (rewrite_args) {
+        Rewriter* rewriter = rewrite_args->rewriter;
+
+        RewriterVar* r_stack;
+        if (nstack) {
+            r_stack = rewriter->allocate(nstack);
+            for (int i = 0; i < nstack; i++) {
+                int idx = i + skip;
+                RewriterVar* r_arg;
+                if (idx == 0)
+                    r_arg = rewrite_args->arg1;
+                else if (idx == 1)
+                    r_arg = rewrite_args->arg2;
+                else if (idx == 2)
+                    r_arg = rewrite_args->arg3;
+                else
+                    r_arg = rewrite_args->args->getAttr((idx - 3) * sizeof(Box*))->setType(RefType::BORROWED);
+                r_stack->setAttr(i * sizeof(Box*), r_arg);
+            }
+        } else {
+            r_stack = rewriter->loadConst(0);
+        }
+
+        RewriterVar* r_nargs = rewriter->loadConst(nargs);
+        if (flags & METH_KEYWORDS) {
+            // The keyword names are fixed for a given call site, so the IC can hold on to this tuple.
+            RewriterVar* r_kwnames;
+            if (kwnames) {
+                rewriter->addGCReference(kwnames);
+                r_kwnames = rewriter->loadConst((intptr_t)kwnames);
+            } else {
+                r_kwnames = rewriter->loadConst(0);
+            }
+            rewrite_args->out_rtn = rewriter->call(true, (void*)method_def->ml_meth, r_self, r_stack, r_nargs,
+                                                   r_kwnames)->setType(RefType::OWNED);
+        } else {
+            rewrite_args->out_rtn
+                = rewriter->call(true, (void*)method_def->ml_meth, r_self, r_stack, r_nargs)->setType(RefType::OWNED);
+        }
+    }
+
+    Box* rtn;
+    if (flags & METH_KEYWORDS)
+        rtn = ((_PyCFunctionFastWithKeywords)method_def->ml_meth)(self, stack, nargs, kwnames);
+    else
+        rtn = ((_PyCFunctionFast)method_def->ml_meth)(self, stack, nargs);
+
+    if (rewrite_args) {
+        if (S == CXX)
+            rewrite_args->rewriter->checkAndThrowCAPIException(rewrite_args->out_rtn);
+        rewrite_args->out_success = true;
+    }
+
+    if (S == CXX && !rtn)
+        throwCAPIException();
+    return rtn;
+}
+
+template Box* callFastCallFunction<CAPI>(PyMethodDef*, Box*, RewriterVar*, CallRewriteArgs*, ArgPassSpec, int, Box*,
+                                         Box*, Box*, Box**, const std::vector<BoxedString*>*);
+template Box* callFastCallFunction<CXX>(PyMethodDef*, Box*, RewriterVar*, CallRewriteArgs*, ArgPassSpec, int, Box*,
+                                        Box*, Box*, Box**, const std::vector<BoxedString*>*);
+
+Box* callFastCallFunctionFromTuple(PyMethodDef* method_def, Box* self, BoxedTuple* varargs,
+                                   BoxedDict* kwargs) noexcept {
+    int flags = method_def->ml_flags & ~(METH_CLASS | METH_STATIC | METH_COEXIST);
+    assert(flags & METH_FASTCALL);
+    assert(varargs->cls == tuple_cls);
+
+    int nargs = varargs->size();
+    if (!(flags & METH_KEYWORDS)) {
+        assert(!kwargs || !kwargs->d.size());
+        return ((_PyCFunctionFast)method_def->ml_meth)(self, &varargs->elts[0], nargs);
+    }
+
+    if (!kwargs || !kwargs->d.size())
+        return ((_PyCFunctionFastWithKeywords)method_def->ml_meth)(self, &varargs->elts[0], nargs, NULL);
+
+    int nkw = kwargs->d.size();
+    llvm::SmallVector<Box*, 8> stack(nargs + nkw);
+    std::copy(&varargs->elts[0], &varargs->elts[nargs], stack.begin());
+
+    BoxedTuple* kwnames = BoxedTuple::create(nkw);
+    AUTO_DECREF(kwnames);
+    int i = 0;
+    for (auto&& p : *kwargs) {
+        // The dict may have been given unicode keys; the argument parsers expect str.
+        Box* name = coerceUnicodeToStr<CAPI>(p.first);
+        if (!name)
+            return NULL;
+        kwnames->elts[i] = name;
+        stack[nargs + i] = p.second;
+        i++;
+    }
+
+    return ((_PyCFunctionFastWithKeywords)method_def->ml_meth)(self, stack.data(), nargs, kwnames);
+}
+
 Box* BoxedCApiFunction::__call__(BoxedCApiFunction* self, BoxedTuple* varargs, BoxedDict* kwargs) {
     STAT_TIMER(t0, "us_timer_boxedcapifunction__call__", (self->cls->is_user_defined ? 10 : 20));
     assert(self->cls == capifunc_cls);
@@ -1419,7 +1539,19 @@ Box* BoxedCApiFunction::tppCall(Box* _self, CallRewriteArgs* rewrite_args, ArgPa
 
     ParamReceiveSpec paramspec(0, 0, true, false);
     Box** defaults = NULL;
-    if (flags == METH_VARARGS) {
+    if (flags & METH_FASTCALL) {
+        if (!argspec.has_starargs && !argspec.has_kwargs && (!argspec.num_keywords || (flags & METH_KEYWORDS))) {
+            RewriterVar* r_passthrough = NULL;
+            if (rewrite_args)
+                r_passthrough = rewrite_args->rewriter->loadConst((intptr_t)self->passthrough, Location::forArg(0));
+            return callFastCallFunction<S>(self->method_def, self->passthrough, r_passthrough, rewrite_args, argspec,
+                                           0, arg1, arg2, arg3, args, keyword_names);
+        }
+
+        // Otherwise let rearrangeArguments deal with the * and ** arguments (and any errors), and
+        // unpack the tuple and dict it produces.
+        paramspec = ParamReceiveSpec(0, 0, true, flags & METH_KEYWORDS);
+    } else if (flags == METH_VARARGS) {
         paramspec = ParamReceiveSpec(0, 0, true, false);
     } else if (flags == (METH_VARARGS | METH_KEYWORDS)) {
         paramspec = ParamReceiveSpec(0, 0, true, true);
@@ -1487,7 +1619,11 @@ Box* BoxedCApiFunction::tppCall(Box* _self, CallRewriteArgs* rewrite_args, ArgPa
             r_passthrough = rewrite_args->rewriter->loadConst((intptr_t)self->passthrough, Location::forArg(0));
 
         Box* rtn;
-        if (flags == METH_VARARGS) {
+        if (flags & METH_FASTCALL) {
+            rewrite_args = NULL;
+            rtn = callFastCallFunctionFromTuple(self->method_def, self->passthrough, static_cast<BoxedTuple*>(arg1),
+                                                (flags & METH_KEYWORDS) ? static_cast<BoxedDict*>(arg2) : NULL);
+        } else if (flags == METH_VARARGS) {
             rtn = (Box*)func(self->passthrough, arg1);
             if (rewrite_args)
                 rewrite_args->out_rtn = rewrite_args->rewriter->call(true, (void*)func, r_passthrough,
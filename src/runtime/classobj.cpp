@@ -57,19 +57,50 @@ static BORROWED(Box*) classLookup(BoxedClassobj* cls, BoxedString* attr, Getattr
 
     if (rewrite_args) {
         if (rewrite_args->isSuccessful()) {
-            rewrite_args->getReturn(); // just to make the asserts happy
+            rewrite_args->assertReturnConvention(ReturnConvention::NO_RETURN);
             rewrite_args->clearReturn();
+
+            // Similar to the tp_mro guard in typeLookup: __bases__ can only be changed by replacing the tuple, which
+            // is immutable, so once we guard on its identity we can treat the base classes as constants.  We keep the
+            // tuple alive so that a different one can't show up at the same address.
+            rewrite_args->obj->addAttrGuard(offsetof(BoxedClassobj, bases), (intptr_t)cls->bases);
+            rewrite_args->rewriter->addGCReference(cls->bases);
+        } else {
+            rewrite_args = NULL;
         }
-        rewrite_args = NULL;
     }
 
     for (auto b : *cls->bases) {
         RELEASE_ASSERT(b->cls == classobj_cls, "");
-        Box* r = classLookup<NOT_REWRITABLE>(static_cast<BoxedClassobj*>(b), attr, rewrite_args);
+
+        if (rewrite_args) {
+            GetattrRewriteArgs base_rewrite_args(rewrite_args->rewriter,
+                                                 rewrite_args->rewriter->loadConst((intptr_t)b, Location::any()),
+                                                 rewrite_args->destination);
+            // Old-style classes can't change their __class__
+            base_rewrite_args.obj_shape_guarded = true;
+
+            Box* r = classLookup<REWRITABLE>(static_cast<BoxedClassobj*>(b), attr, &base_rewrite_args);
+            if (!base_rewrite_args.isSuccessful())
+                rewrite_args = NULL;
+            else if (r)
+                rewrite_args->setReturn(base_rewrite_args.getReturn(ReturnConvention::HAS_RETURN),
+                                        ReturnConvention::HAS_RETURN);
+            else
+                base_rewrite_args.assertReturnConvention(ReturnConvention::NO_RETURN);
+
+            if (r)
+                return r;
+            continue;
+        }
+
+        Box* r = classLookup<NOT_REWRITABLE>(static_cast<BoxedClassobj*>(b), attr, NULL);
         if (r)
             return r;
     }
 
+    if (rewrite_args)
+        rewrite_args->setReturn(NULL, ReturnConvention::NO_RETURN);
     return NULL;
 }
 
@@ -364,9 +395,13 @@ Box* classobjRepr(Box* _obj) {
 }
 
 // Analogous to CPython's instance_getattr2
+//
+// If for_call is set, functions found on the class are returned unbound, with the instance stored in *bind_obj_out,
+// the same way that getattrInternalGeneric does it for new-style objects.  This saves creating an instancemethod
+// for every method call.
 template <Rewritable rewritable>
-static Box* instanceGetattributeSimple(BoxedInstance* inst, BoxedString* attr_str,
-                                       GetattrRewriteArgs* rewrite_args = NULL) {
+static Box* instanceGetattributeSimple(BoxedInstance* inst, BoxedString* attr_str, GetattrRewriteArgs* rewrite_args,
+                                       bool for_call, BORROWED(Box**) bind_obj_out, RewriterVar** r_bind_obj_out) {
     if (rewritable == NOT_REWRITABLE) {
         assert(!rewrite_args);
         rewrite_args = NULL;
@@ -399,6 +434,17 @@ static Box* instanceGetattributeSimple(BoxedInstance* inst, BoxedString* attr_st
         rewrite_args = NULL;
 
     if (r) {
+        if (for_call && r->cls == function_cls) {
+            if (rewrite_args) {
+                RewriterVar* r_func = grewriter_inst_args.getReturn(ReturnConvention::HAS_RETURN);
+                r_func->addAttrGuard(offsetof(Box, cls), (intptr_t)function_cls);
+                rewrite_args->setReturn(r_func, ReturnConvention::HAS_RETURN);
+                *r_bind_obj_out = r_inst;
+            }
+            *bind_obj_out = inst;
+            return incref(r);
+        }
+
         Box* rtn = processDescriptor(r, inst, inst->inst_cls);
         if (rewrite_args) {
             RewriterVar* r_rtn
@@ -416,15 +462,32 @@ static Box* instanceGetattributeSimple(BoxedInstance* inst, BoxedString* attr_st
     return NULL;
 }
 
+// Calls a class's __getattr__ for an attribute that wasn't otherwise found.  This is the rewritten version of the
+// fallback in instanceGetattributeWithFallback, so it uses the CAPI convention in order to work for both kinds of
+// getattr ICs.
+static Box* callInstanceGetattrHook(Box* getattr, BoxedInstance* inst, BoxedString* attr_str) noexcept {
+    try {
+        getattr = processDescriptor(getattr, inst, inst->inst_cls);
+        AUTO_DECREF(getattr);
+        return runtimeCallInternal<CXX, NOT_REWRITABLE>(getattr, NULL, ArgPassSpec(1), attr_str, NULL, NULL, NULL,
+                                                        NULL);
+    } catch (ExcInfo e) {
+        setCAPIException(e);
+        return NULL;
+    }
+}
+
 template <Rewritable rewritable>
 static Box* instanceGetattributeWithFallback(BoxedInstance* inst, BoxedString* attr_str,
-                                             GetattrRewriteArgs* rewrite_args = NULL) {
+                                             GetattrRewriteArgs* rewrite_args, bool for_call,
+                                             BORROWED(Box**) bind_obj_out, RewriterVar** r_bind_obj_out) {
     if (rewritable == NOT_REWRITABLE) {
         assert(!rewrite_args);
         rewrite_args = NULL;
     }
 
-    Box* attr_obj = instanceGetattributeSimple<rewritable>(inst, attr_str, rewrite_args);
+    Box* attr_obj = instanceGetattributeSimple<rewritable>(inst, attr_str, rewrite_args, for_call, bind_obj_out,
+                                                           r_bind_obj_out);
 
     if (attr_obj) {
         if (rewrite_args && rewrite_args->isSuccessful())
@@ -441,31 +504,56 @@ static Box* instanceGetattributeWithFallback(BoxedInstance* inst, BoxedString* a
             rewrite_args->clearReturn();
         }
 
-        // abort rewriting for now
-        rewrite_args = NULL;
+        // The IC has to embed a reference to the attribute name in order to pass it to __getattr__.
+        if (rewrite_args && attr_str->interned_state != SSTATE_INTERNED_IMMORTAL)
+            rewrite_args = NULL;
     }
 
     static BoxedString* getattr_str = getStaticString("__getattr__");
-    Box* getattr = classLookup(inst->inst_cls, getattr_str);
+
+    RewriterVar* r_inst_cls = NULL;
+    if (rewrite_args)
+        r_inst_cls = rewrite_args->obj->getAttr(offsetof(BoxedInstance, inst_cls));
+    GetattrRewriteArgs grewrite_args(rewrite_args ? rewrite_args->rewriter : NULL, r_inst_cls,
+                                     rewrite_args ? rewrite_args->rewriter->getReturnDestination() : Location());
+    Box* getattr = classLookup<rewritable>(inst->inst_cls, getattr_str, rewrite_args ? &grewrite_args : NULL);
+    if (!grewrite_args.isSuccessful())
+        rewrite_args = NULL;
 
     if (getattr) {
+        if (rewrite_args) {
+            RewriterVar* r_rtn
+                = rewrite_args->rewriter->call(true, (void*)callInstanceGetattrHook,
+                                               grewrite_args.getReturn(ReturnConvention::HAS_RETURN), rewrite_args->obj,
+                                               rewrite_args->rewriter->loadConst((intptr_t)attr_str))
+                      ->setType(RefType::OWNED);
+            rewrite_args->setReturn(r_rtn, ReturnConvention::CAPI_RETURN);
+        }
+
         getattr = processDescriptor(getattr, inst, inst->inst_cls);
         AUTO_DECREF(getattr);
         return runtimeCallInternal<CXX, NOT_REWRITABLE>(getattr, NULL, ArgPassSpec(1), attr_str, NULL, NULL, NULL,
                                                         NULL);
     }
 
+    if (rewrite_args)
+        grewrite_args.assertReturnConvention(ReturnConvention::NO_RETURN);
+
     return NULL;
 }
 
 template <Rewritable rewritable>
 static Box* _instanceGetattribute(Box* _inst, BoxedString* attr_str, bool raise_on_missing,
-                                  GetattrRewriteArgs* rewrite_args) {
+                                  GetattrRewriteArgs* rewrite_args, bool for_call = false,
+                                  BORROWED(Box**) bind_obj_out = NULL, RewriterVar** r_bind_obj_out = NULL) {
     if (rewritable == NOT_REWRITABLE) {
         assert(!rewrite_args);
         rewrite_args = NULL;
     }
 
+    if (for_call)
+        *bind_obj_out = NULL;
+
     RELEASE_ASSERT(_inst->cls == instance_cls, "");
     BoxedInstance* inst = static_cast<BoxedInstance*>(_inst);
 
@@ -479,7 +567,8 @@ static Box* _instanceGetattribute(Box* _inst, BoxedString* attr_str, bool raise_
     }
 
     try {
-        Box* attr = instanceGetattributeWithFallback<rewritable>(inst, attr_str, rewrite_args);
+        Box* attr = instanceGetattributeWithFallback<rewritable>(inst, attr_str, rewrite_args, for_call, bind_obj_out,
+                                                                 r_bind_obj_out);
         if (attr)
             return attr;
     } catch (ExcInfo e) {
@@ -506,7 +595,8 @@ Box* instance_getattro(Box* cls, Box* attr) noexcept {
 }
 
 template <ExceptionStyle S>
-Box* instanceGetattroInternal(Box* cls, Box* _attr, GetattrRewriteArgs* rewrite_args) noexcept(S == CAPI) {
+Box* instanceGetattroInternal(Box* cls, Box* _attr, GetattrRewriteArgs* rewrite_args, bool for_call,
+                              BORROWED(Box**) bind_obj_out, RewriterVar** r_bind_obj_out) noexcept(S == CAPI) {
     STAT_TIMER(t0, "us_timer_instance_getattro", 0);
 
     RELEASE_ASSERT(_attr->cls == str_cls, "");
@@ -514,19 +604,21 @@ Box* instanceGetattroInternal(Box* cls, Box* _attr, GetattrRewriteArgs* rewrite_
 
     if (S == CAPI) {
         try {
-            return _instanceGetattribute<REWRITABLE>(cls, attr, true, rewrite_args);
+            return _instanceGetattribute<REWRITABLE>(cls, attr, true, rewrite_args, for_call, bind_obj_out,
+                                                     r_bind_obj_out);
         } catch (ExcInfo e) {
             setCAPIException(e);
             return NULL;
         }
     } else {
-        return _instanceGetattribute<REWRITABLE>(cls, attr, true, rewrite_args);
+        return _instanceGetattribute<REWRITABLE>(cls, attr, true, rewrite_args, for_call, bind_obj_out,
+                                                 r_bind_obj_out);
     }
 }
 
 // Force instantiation of the template
-template Box* instanceGetattroInternal<CAPI>(Box*, Box*, GetattrRewriteArgs*) noexcept;
-template Box* instanceGetattroInternal<CXX>(Box*, Box*, GetattrRewriteArgs*);
+template Box* instanceGetattroInternal<CAPI>(Box*, Box*, GetattrRewriteArgs*, bool, Box**, RewriterVar**) noexcept;
+template Box* instanceGetattroInternal<CXX>(Box*, Box*, GetattrRewriteArgs*, bool, Box**, RewriterVar**);
 
 void instanceSetattroInternal(Box* _inst, Box* _attr, STOLEN(Box*) value, SetattrRewriteArgs* rewrite_args) {
     STAT_TIMER(t0, "us_timer_instance_setattro", 0);
@@ -1980,7 +2072,8 @@ void BoxedInstance::dealloc(Box* b) noexcept {
     // if (delstr && (del = instance_getattr2(inst, delstr)) != NULL) {
     // TODO: not sure if this is the same as cpython's getattr2 (and the exception style might be different too?)
     if (delstr
-        && (del = instanceGetattributeSimple<NOT_REWRITABLE>(inst, static_cast<BoxedString*>(delstr), NULL)) != NULL) {
+        && (del = instanceGetattributeSimple<NOT_REWRITABLE>(inst, static_cast<BoxedString*>(delstr), NULL, false, NULL,
+                                                             NULL)) != NULL) {
         PyObject* res = PyEval_CallObject(del, (PyObject*)NULL);
         if (res == NULL)
             PyErr_WriteUnraisable(del);
@@ -79,7 +79,9 @@ Box* instance_getattro(Box* cls, Box* attr) noexcept;
 int instance_setattro(Box* cls, Box* attr, Box* value) noexcept;
 class GetattrRewriteArgs;
 template <ExceptionStyle S>
-Box* instanceGetattroInternal(Box* self, Box* attr, GetattrRewriteArgs* rewrite_args) noexcept(S == CAPI);
+Box* instanceGetattroInternal(Box* self, Box* attr, GetattrRewriteArgs* rewrite_args, bool for_call = false,
+                              BORROWED(Box**) bind_obj_out = NULL,
+                              RewriterVar** r_bind_obj_out = NULL) noexcept(S == CAPI);
 void instanceSetattroInternal(Box* self, STOLEN(Box*) attr, Box* val, SetattrRewriteArgs* rewrite_args);
 }
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "capi/typeobject.h"
+#include "capi/types.h"
 #include "codegen/compvars.h"
 #include "runtime/objmodel.h"
 #include "runtime/rewrite_args.h"
@@ -254,7 +255,9 @@ Box* methodDescrTppCall(Box* _self, CallRewriteArgs* rewrite_args, ArgPassSpec a
 
     ParamReceiveSpec paramspec(0, 0, false, false);
     Box** defaults = NULL;
-    if (call_flags == METH_NOARGS) {
+    if (call_flags & METH_FASTCALL) {
+        paramspec = ParamReceiveSpec(1, 0, true, call_flags & METH_KEYWORDS);
+    } else if (call_flags == METH_NOARGS) {
         paramspec = ParamReceiveSpec(1, 0, false, false);
     } else if (call_flags == METH_VARARGS) {
         paramspec = ParamReceiveSpec(1, 0, true, false);
@@ -292,6 +295,18 @@ Box* methodDescrTppCall(Box* _self, CallRewriteArgs* rewrite_args, ArgPassSpec a
         arg1_class_guarded = true;
     }
 
+    // METH_FASTCALL methods can take their arguments straight from our calling convention, as long as
+    // there are no * or ** arguments to unpack.
+    if ((call_flags & METH_FASTCALL) && !is_classmethod && argspec.num_args >= 1 && !argspec.has_starargs
+        && !argspec.has_kwargs && (!argspec.num_keywords || (call_flags & METH_KEYWORDS))) {
+        if (!isSubclass(arg1->cls, self->d_type))
+            raiseExcHelper(TypeError, "descriptor '%s' requires a '%s' arg1 but received a '%s'",
+                           self->d_method->ml_name, self->d_type->tp_name, getFullTypeName(arg1).c_str());
+
+        return callFastCallFunction<CXX>(self->d_method, arg1, rewrite_args ? rewrite_args->arg1 : NULL,
+                                         rewrite_args, argspec, 1, arg1, arg2, arg3, args, keyword_names);
+    }
+
     auto continuation = [=](CallRewriteArgs* rewrite_args, Box* arg1, Box* arg2, Box* arg3, Box** args) {
         if (is_classmethod) {
             rewrite_args = NULL;
@@ -309,7 +324,15 @@ Box* methodDescrTppCall(Box* _self, CallRewriteArgs* rewrite_args, ArgPassSpec a
         }
 
         Box* rtn;
-        if (call_flags == METH_NOARGS) {
+        if (call_flags & METH_FASTCALL) {
+            rewrite_args = NULL;
+            {
+                UNAVOIDABLE_STAT_TIMER(t0, "us_timer_in_builtins");
+                rtn = callFastCallFunctionFromTuple(self->d_method, arg1, static_cast<BoxedTuple*>(arg2),
+                                                    (call_flags & METH_KEYWORDS) ? static_cast<BoxedDict*>(arg3)
+                                                                                 : NULL);
+            }
+        } else if (call_flags == METH_NOARGS) {
             {
                 UNAVOIDABLE_STAT_TIMER(t0, "us_timer_in_builtins");
                 rtn = (Box*)self->d_method->ml_meth(arg1, NULL);
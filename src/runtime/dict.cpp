@@ -34,6 +34,8 @@ BoxedClass* dictitervalue_cls = NULL;
 BoxedClass* dictiteritem_cls = NULL;
 }
 
+uint64_t BoxedDict::last_keys_version = 0;
+
 static void _dictSetStolen(BoxedDict* self, BoxAndHash k, STOLEN(Box*) v) {
     Box** slot = NULL;
     try {
@@ -49,6 +51,7 @@ static void _dictSetStolen(BoxedDict* self, BoxAndHash k, STOLEN(Box*) v) {
     if (old_val) {
         Py_DECREF(old_val);
     } else {
+        self->keysChanged();
         Py_INCREF(k.value);
     }
 }
@@ -128,6 +131,7 @@ Box* dictCopy(BoxedDict* self) {
         Py_INCREF(p.second);
     }
     r->d = self->d;
+    r->keysChanged();
     return r;
 }
 
@@ -222,6 +226,7 @@ extern "C" void PyDict_Clear(PyObject* op) noexcept {
         Py_DECREF(p.second);
     }
     static_cast<BoxedDict*>(op)->d.freeAllMemory();
+    static_cast<BoxedDict*>(op)->keysChanged();
 }
 
 Box* dictClear(BoxedDict* self) {
@@ -314,6 +319,118 @@ template <enum ExceptionStyle S> Box* dictGetitem(BoxedDict* self, Box* k) noexc
     return incref(it->second);
 }
 
+// d[k], d[k] = v and k in d on an exact dict with a str key get rewritten to call the functions below.  Besides
+// skipping the generic dispatch, they remember which bucket a key was last found in: if the dict holds that exact key
+// object, then as long as the dict's keys_version stays the same the key stays in that bucket (and stays alive, so
+// its address can't get reused by a different string).  For the usual constant keys a repeated lookup is then just
+// a compare and a load.
+namespace {
+struct StrKeyCacheEntry {
+    uint64_t keys_version;
+    BoxedString* key;
+    Box** value;
+};
+}
+static const int STR_KEY_CACHE_SIZE = 1024;
+static_assert((STR_KEY_CACHE_SIZE & (STR_KEY_CACHE_SIZE - 1)) == 0, "should be a power of two");
+static StrKeyCacheEntry str_key_cache[STR_KEY_CACHE_SIZE];
+
+static StrKeyCacheEntry& strKeyCacheEntry(BoxedDict* self, BoxedString* key) {
+    size_t idx = (self->keys_version * 31) ^ ((uintptr_t)key >> 4);
+    return str_key_cache[idx & (STR_KEY_CACHE_SIZE - 1)];
+}
+
+extern "C" Box* dictGetitemStrCapi(BoxedDict* self, BoxedString* key) noexcept {
+    assert(self->cls == dict_cls);
+    assert(key->cls == str_cls);
+
+    StrKeyCacheEntry& entry = strKeyCacheEntry(self, key);
+    if (entry.keys_version == self->keys_version && entry.key == key)
+        return incref(*entry.value);
+
+    // The lookup can call __eq__ on other keys, which could modify the dict.
+    uint64_t keys_version = self->keys_version;
+    BoxedDict::DictMap::iterator it;
+    try {
+        it = self->d.find(BoxAndHash(key));
+    } catch (ExcInfo e) {
+        setCAPIException(e);
+        return NULL;
+    }
+
+    if (it == self->d.end()) {
+        PyErr_SetObject(KeyError, autoDecref(BoxedTuple::create1(key)));
+        return NULL;
+    }
+
+    if (it->first.value == key && self->keys_version == keys_version)
+        entry = { keys_version, key, &it->second };
+    return incref(it->second);
+}
+
+extern "C" int dictSetitemStrCapi(BoxedDict* self, BoxedString* key, Box* v) noexcept {
+    assert(self->cls == dict_cls);
+    assert(key->cls == str_cls);
+
+    StrKeyCacheEntry& entry = strKeyCacheEntry(self, key);
+    Box** slot;
+    bool cacheable = true;
+    if (entry.keys_version == self->keys_version && entry.key == key) {
+        slot = entry.value;
+    } else {
+        uint64_t keys_version = self->keys_version;
+        try {
+            auto& p = self->d.FindAndConstruct(BoxAndHash(key));
+            slot = &p.second;
+            cacheable = (p.first.value == key && self->keys_version == keys_version);
+        } catch (ExcInfo e) {
+            setCAPIException(e);
+            return -1;
+        }
+    }
+
+    Box* old_val = *slot;
+    *slot = incref(v);
+    if (!old_val) {
+        Py_INCREF(key);
+        self->keysChanged();
+    }
+
+    // Adding the key changes keys_version, so this isn't necessarily the entry we looked at above.
+    if (cacheable)
+        strKeyCacheEntry(self, key) = { self->keys_version, key, slot };
+
+    // Do this last, since it might run arbitrary code.
+    Py_XDECREF(old_val);
+    return 0;
+}
+
+// `key in d`, using the same cache as dictGetitemStrCapi.
+extern "C" int dictContainsStrCapi(BoxedDict* self, BoxedString* key) noexcept {
+    assert(self->cls == dict_cls);
+    assert(key->cls == str_cls);
+
+    StrKeyCacheEntry& entry = strKeyCacheEntry(self, key);
+    if (entry.keys_version == self->keys_version && entry.key == key)
+        return 1;
+
+    uint64_t keys_version = self->keys_version;
+    BoxedDict::DictMap::iterator it;
+    try {
+        it = self->d.find(BoxAndHash(key));
+    } catch (ExcInfo e) {
+        setCAPIException(e);
+        return -1;
+    }
+
+    if (it == self->d.end())
+        return 0;
+
+    if (it->first.value == key && self->keys_version == keys_version)
+        entry = { keys_version, key, &it->second };
+    return 1;
+}
+
 extern "C" PyObject* PyDict_New() noexcept {
     return new BoxedDict();
 }
@@ -479,6 +596,7 @@ Box* dictDelitem(BoxedDict* self, Box* k) {
     Box* old_k = it->first.value;
     Box* v = it->second;
     self->d.erase(it);
+    self->keysChanged();
     Py_DECREF(v);
     Py_DECREF(old_k);
 
@@ -521,6 +639,7 @@ extern "C" int PyDict_DelItem(PyObject* op, PyObject* key) noexcept {
         Box* v = it->second;
         Box* k = it->first.value;
         self->d.erase(it);
+        self->keysChanged();
         Py_DECREF(v);
         Py_DECREF(k);
 
@@ -557,6 +676,7 @@ Box* dictPop(BoxedDict* self, Box* k, Box* d) {
     Box* rtn = it->second;
     Box* old_k = it->first.value;
     self->d.erase(it);
+    self->keysChanged();
     Py_DECREF(old_k);
     return rtn;
 }
@@ -574,6 +694,7 @@ Box* dictPopitem(BoxedDict* self) {
     Box* key = it->first.value;
     Box* value = it->second;
     self->d.erase(it);
+    self->keysChanged();
 
     auto rtn = BoxedTuple::create({ key, value });
     Py_DECREF(key);
@@ -605,6 +726,7 @@ Box* dictSetdefault(BoxedDict* self, Box* k, Box* v) {
     Py_INCREF(k);
     Py_INCREF(v);
     self->d.insert(std::make_pair(k_hash, v));
+    self->keysChanged();
 
     return incref(v);
 }
@@ -657,6 +779,7 @@ Box* dictFromkeys(Box* cls, Box* iterable, Box* default_value) {
             Py_INCREF(default_value);
             rtn->d.insert(std::make_pair(elt, default_value));
         }
+        rtn->keysChanged();
     } else {
         for (Box* e : iterable->pyElements()) {
             AUTO_DECREF(e);
@@ -41,6 +41,9 @@ public:
 };
 
 Box* dictGetitem(BoxedDict* self, Box* k);
+extern "C" Box* dictGetitemStrCapi(BoxedDict* self, BoxedString* key) noexcept;
+extern "C" int dictSetitemStrCapi(BoxedDict* self, BoxedString* key, Box* v) noexcept;
+extern "C" int dictContainsStrCapi(BoxedDict* self, BoxedString* key) noexcept;
 
 Box* dict_iter(Box* s) noexcept;
 Box* dictIterKeys(Box* self);
@@ -53,6 +56,7 @@ Box* dictiter_next(Box* self) noexcept;
 Box* dictIterNext(Box* self);
 
 
+Box* dictCopy(BoxedDict* self);
 void dictMerge(BoxedDict* self, Box* other);
 Box* dictUpdate(BoxedDict* self, BoxedTuple* args, BoxedDict* kwargs);
 }
@@ -59,6 +59,9 @@ void HiddenClassSingleton::appendAttribute(BoxedString* attr) {
     assert(attr->interned_state != SSTATE_NOT_INTERNED);
     assert(type == SINGLETON);
     dependent_getattrs.invalidateAll();
+    auto it = dependent_attr_getattrs.find(attr);
+    if (it != dependent_attr_getattrs.end())
+        it->second->invalidateAll();
     assert(attr_offsets.count(attr) == 0);
     int n = this->attributeArraySize();
     attr_offsets[attr] = n;
@@ -74,7 +77,8 @@ void HiddenClassSingleton::appendAttrwrapper() {
 void HiddenClassSingleton::delAttribute(BoxedString* attr) {
     assert(attr->interned_state != SSTATE_NOT_INTERNED);
     assert(type == SINGLETON);
-    dependent_getattrs.invalidateAll();
+    // This shifts the offsets of the attributes after attr, so everything has to go.
+    invalidateAll();
     assert(attr_offsets.count(attr));
 
     int prev_idx = attr_offsets[attr];
@@ -94,6 +98,20 @@ void HiddenClassSingleton::addDependence(Rewriter* rewriter) {
     rewriter->addDependenceOn(dependent_getattrs);
 }
 
+void HiddenClassSingleton::addDependence(Rewriter* rewriter, BoxedString* attr) {
+    assert(type == SINGLETON);
+    std::unique_ptr<ICInvalidator>& invalidator = dependent_attr_getattrs[attr];
+    if (!invalidator)
+        invalidator.reset(new ICInvalidator());
+    rewriter->addDependenceOn(*invalidator);
+}
+
+void HiddenClassSingleton::invalidateAll() {
+    dependent_getattrs.invalidateAll();
+    for (auto& p : dependent_attr_getattrs)
+        p.second->invalidateAll();
+}
+
 HiddenClassNormal* HiddenClassNormal::getOrMakeChild(BoxedString* attr) {
     STAT_TIMER(t0, "us_timer_hiddenclass_getOrMakeChild", 0);
 
@@ -15,7 +15,9 @@
 #ifndef PYSTON_RUNTIME_HIDDENCLASS_H
 #define PYSTON_RUNTIME_HIDDENCLASS_H
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/StringMap.h>
+#include <memory>
 
 #include "Python.h"
 
@@ -159,13 +161,18 @@ protected:
     HiddenClassSingleton() : HiddenClassSingletonOrNormal(HiddenClass::SINGLETON) {}
 
     ICInvalidator dependent_getattrs;
+    // ICs that only depend on where one attribute is stored (or on it not existing), like the ones that getGlobal()
+    // creates.  Adding some other attribute doesn't affect those, so they only get invalidated when this attribute
+    // gets added or when attributes move around.
+    llvm::DenseMap<BoxedString*, std::unique_ptr<ICInvalidator>> dependent_attr_getattrs;
 
 public:
     void appendAttribute(BoxedString* attr);
     void appendAttrwrapper();
     void delAttribute(BoxedString* attr);
     void addDependence(Rewriter* rewriter);
-    void invalidateAll() { dependent_getattrs.invalidateAll(); }
+    void addDependence(Rewriter* rewriter, BoxedString* attr);
+    void invalidateAll();
 
     friend class HiddenClass;
 };
@@ -310,4 +310,50 @@ RuntimeIC::~RuntimeIC() {
     } else {
     }
 }
+
+// The ICs assume the attribute name is constant for a given caller, so the name is part of the key.  Only immortal
+// strings can be used as keys, since the address of a mortal one could get reused for a different name.
+static bool canUseCapiCallerIC(BoxedString* attr) {
+    return ENABLE_RUNTIME_ICS && attr->interned_state == SSTATE_INTERNED_IMMORTAL;
+}
+
+Box* getattrFromCapiCaller(Box* obj, BoxedString* attr, void* caller_addr) noexcept {
+    if (canUseCapiCallerIC(attr)) {
+        static KeyedRuntimeICCache<GetattrCapiIC, 256> cache;
+        std::shared_ptr<GetattrCapiIC> ic = cache.getIC(caller_addr, attr, 0);
+        if (ic)
+            return ic->call(obj, attr);
+    }
+
+    static StatCounter num_capi_getattr_no_ic("num_capi_getattr_no_ic");
+    num_capi_getattr_no_ic.log();
+
+    Box* r = getattrInternal<CAPI>(obj, attr);
+    if (!r && !PyErr_Occurred())
+        raiseAttributeErrorCapi(obj, attr->s());
+    return r;
+}
+
+Box* callattrFromCapiCaller(Box* obj, BoxedString* attr, ArgPassSpec argspec, Box* arg1, Box* arg2, Box* arg3,
+                            Box** args, void* caller_addr) noexcept {
+    assert(!argspec.num_keywords);
+
+    if (canUseCapiCallerIC(attr)) {
+        static KeyedRuntimeICCache<CallattrCapiIC, 256> cache;
+        std::shared_ptr<CallattrCapiIC> ic = cache.getIC(caller_addr, attr, argspec.asInt());
+        if (ic) {
+            CallattrFlags flags{.cls_only = false, .null_on_nonexistent = false, .argspec = argspec };
+            return ic->call(obj, attr, flags, arg1, arg2, arg3, args, NULL);
+        }
+    }
+
+    static StatCounter num_capi_callattr_no_ic("num_capi_callattr_no_ic");
+    num_capi_callattr_no_ic.log();
+
+    Box* r = callattrInternal<CAPI, NOT_REWRITABLE>(obj, attr, CLASS_OR_INST, NULL, argspec, arg1, arg2, arg3, args,
+                                                    NULL);
+    if (!r && !PyErr_Occurred())
+        raiseAttributeErrorCapi(obj, attr->s());
+    return r;
+}
 }
@@ -75,6 +75,13 @@ public:
 };
 
 
+class GetattrCapiIC : public RuntimeIC {
+public:
+    GetattrCapiIC() : RuntimeIC((void*)getattr_capi, 512) {}
+
+    Box* call(Box* obj, BoxedString* attr) { return (Box*)call_ptr(obj, attr); }
+};
+
 class BinopIC : public RuntimeIC {
 public:
     BinopIC() : RuntimeIC((void*)binop, 512) {}
@@ -139,6 +146,69 @@ public:
     }
 };
 
+// Like RuntimeICCache, but for entry points whose callers can pass different attribute names or argument counts.
+// The ICs assume that those are constant, so they are part of the key.
+// The cache is direct-mapped, and an entry only gets replaced after it has seen several misses in a row, so that
+// callers which pass lots of different keys don't keep creating new ICs.
+template <class ICType, unsigned cache_size> class KeyedRuntimeICCache {
+private:
+    static_assert((cache_size & (cache_size - 1)) == 0, "cache_size needs to be a power of two");
+    static const unsigned MISSES_BEFORE_REPLACING = 16;
+
+    struct Entry {
+        void* caller_addr;
+        const void* key;
+        uint64_t subkey;
+        unsigned misses;
+        std::shared_ptr<ICType> ic;
+    };
+    Entry entries[cache_size];
+
+    KeyedRuntimeICCache(const KeyedRuntimeICCache&) = delete;
+    void operator=(const KeyedRuntimeICCache&) = delete;
+
+public:
+    KeyedRuntimeICCache() {
+        for (unsigned i = 0; i < cache_size; ++i) {
+            entries[i].caller_addr = 0;
+            entries[i].key = 0;
+            entries[i].subkey = 0;
+            entries[i].misses = 0;
+        }
+    }
+
+    // Returns NULL if there is no IC for this caller and key, and we don't want to create one yet.
+    std::shared_ptr<ICType> getIC(void* caller_addr, const void* key, uint64_t subkey) {
+        assert(caller_addr);
+
+        uint64_t hash = (uint64_t)caller_addr ^ ((uint64_t)key >> 3) ^ (subkey * 0x9e3779b97f4a7c15ULL);
+        hash ^= hash >> 17;
+        Entry& entry = entries[hash & (cache_size - 1)];
+
+        if (entry.caller_addr == caller_addr && entry.key == key && entry.subkey == subkey) {
+            entry.misses = 0;
+            return entry.ic;
+        }
+
+        if (entry.caller_addr && ++entry.misses < MISSES_BEFORE_REPLACING)
+            return NULL;
+
+        entry.caller_addr = caller_addr;
+        entry.key = key;
+        entry.subkey = subkey;
+        entry.misses = 0;
+        entry.ic = std::make_shared<ICType>();
+        return entry.ic;
+    }
+};
+
+// Attribute lookups and method calls made through the C API (PyObject_GetAttr, PyObject_CallMethod, etc) don't come
+// from a patchpoint, so these give each C caller its own runtime IC.  caller_addr should be the return address of the
+// C API function.  They follow the CAPI exception convention, and raise AttributeError if the attribute doesn't exist.
+Box* getattrFromCapiCaller(Box* obj, BoxedString* attr, void* caller_addr) noexcept;
+Box* callattrFromCapiCaller(Box* obj, BoxedString* attr, ArgPassSpec argspec, Box* arg1, Box* arg2, Box* arg3,
+                            Box** args, void* caller_addr) noexcept;
+
 } // namespace pyston
 
 #endif
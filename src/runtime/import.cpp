@@ -166,7 +166,7 @@ BoxedModule* importCExtension(BoxedString* full_name, const std::string& last_na
     checkAndThrowCAPIException();
 
     BoxedDict* sys_modules = getSysModulesDict();
-    Box* _m = sys_modules->d[full_name];
+    Box* _m = sys_modules->getOrNull(full_name);
     RELEASE_ASSERT(_m, "dynamic module not initialized properly");
     assert(_m->cls == module_cls);
 
@@ -27,7 +27,7 @@
 #include "runtime/types.h"
 #include "runtime/util.h"
 
-extern "C" PyObject* listsort(PyListObject* self, PyObject* args, PyObject* kwds) noexcept;
+extern "C" PyObject* listsort(PyListObject* self, PyObject** args, Py_ssize_t nargs, PyObject* kwnames) noexcept;
 
 namespace pyston {
 
@@ -268,6 +268,20 @@ extern "C" Box* listGetitemInt(BoxedList* self, BoxedInt* slice) {
     return incref(listGetitemUnboxed(self, slice->n));
 }
 
+// The getitem IC calls this directly once it has guarded that the target is an exact list and the index an
+// exact int, so that list[int] doesn't have to go through mp_subscript's index dispatch.
+extern "C" Box* listGetitemUnboxedCapi(BoxedList* self, int64_t n) noexcept {
+    assert(PyList_Check(self));
+    if (n < 0)
+        n = self->size + n;
+
+    if (unlikely(n < 0 || n >= self->size)) {
+        PyErr_SetString(IndexError, "list index out of range");
+        return NULL;
+    }
+    return incref(self->elts->elts[n]);
+}
+
 extern "C" BORROWED(PyObject*) PyList_GetItem(PyObject* op, Py_ssize_t i) noexcept {
     RELEASE_ASSERT(PyList_Check(op), "");
     RELEASE_ASSERT(i >= 0, ""); // unlike list.__getitem__, PyList_GetItem doesn't do index wrapping
@@ -365,6 +379,24 @@ extern "C" Box* listSetitemInt(BoxedList* self, BoxedInt* slice, Box* v) {
     return listSetitemUnboxed(self, slice->n, v);
 }
 
+// The setitem counterpart of listGetitemUnboxedCapi.
+extern "C" int listSetitemUnboxedCapi(BoxedList* self, int64_t n, Box* v) noexcept {
+    assert(PyList_Check(self));
+    if (n < 0)
+        n = self->size + n;
+
+    if (unlikely(n < 0 || n >= self->size)) {
+        PyErr_SetString(IndexError, "list assignment index out of range");
+        return -1;
+    }
+
+    Py_INCREF(v);
+    Box* prev = self->elts->elts[n];
+    self->elts->elts[n] = v;
+    Py_DECREF(prev);
+    return 0;
+}
+
 // Analoguous to CPython's, used for sq_ slots.
 static int list_ass_item(PyListObject* a, Py_ssize_t i, PyObject* v) {
     PyObject* old_value;
@@ -928,75 +960,6 @@ extern "C" int PyList_Reverse(PyObject* v) noexcept {
     return 0;
 }
 
-class PyCmpComparer {
-private:
-    Box* cmp;
-
-public:
-    PyCmpComparer(Box* cmp) : cmp(cmp) {}
-    bool operator()(Box* lhs, Box* rhs) {
-        Box* r = runtimeCallInternal<CXX, NOT_REWRITABLE>(cmp, NULL, ArgPassSpec(2), lhs, rhs, NULL, NULL, NULL);
-        AUTO_DECREF(r);
-        if (!PyInt_Check(r))
-            raiseExcHelper(TypeError, "comparison function must return int, not %.200s", r->cls->tp_name);
-        return static_cast<BoxedInt*>(r)->n < 0;
-    }
-};
-
-void _sortArray(Box** elts, long num_elts, Box* cmp, Box* key) {
-    // TODO(kmod): maybe we should just switch to CPython's sort.  not sure how the algorithms compare,
-    // but they specifically try to support cases where __lt__ or the cmp function might end up inspecting
-    // the current list being sorted.
-    // I also don't know if std::stable_sort is exception-safe.
-
-    if (cmp) {
-        assert(!key);
-        std::stable_sort<Box**, PyCmpComparer>(elts, elts + num_elts, PyCmpComparer(cmp));
-    } else {
-        int num_keys_added = 0;
-        auto remove_keys = [&]() {
-            for (int i = 0; i < num_keys_added; i++) {
-                Box** obj_loc = &elts[i];
-                assert((*obj_loc)->cls == tuple_cls);
-                BoxedTuple* t = static_cast<BoxedTuple*>(*obj_loc);
-                *obj_loc = t->elts[2];
-                Py_DECREF(t);
-            }
-        };
-
-        try {
-            if (key) {
-                for (int i = 0; i < num_elts; i++) {
-                    Box** obj_loc = &elts[i];
-
-                    Box* key_val = runtimeCall(key, ArgPassSpec(1), *obj_loc, NULL, NULL, NULL, NULL);
-                    AUTO_DECREF(key_val);
-
-                    // Add the index as part of the new tuple so that the comparison never hits the
-                    // original object.
-                    // TODO we could potentially make this faster by copying the CPython approach of
-                    // creating special sortwrapper objects that compare only based on the key.
-                    Box* new_obj = BoxedTuple::create({ key_val, autoDecref(boxInt(i)), *obj_loc });
-
-                    *obj_loc = new_obj;
-                    num_keys_added++;
-                }
-            }
-
-            // We don't need to do a stable sort if there's a keyfunc, since we explicitly added the index
-            // as part of the sort key.
-            // But we might want to get rid of that approach?  CPython doesn't do that (they create special
-            // wrapper objects that compare only based on the key).
-            std::stable_sort<Box**, PyLt>(elts, elts + num_elts, PyLt());
-        } catch (ExcInfo e) {
-            remove_keys();
-            throw e;
-        }
-
-        remove_keys();
-    }
-}
-
 extern "C" Box* PyList_GetSlice(PyObject* a, Py_ssize_t ilow, Py_ssize_t ihigh) noexcept {
     assert(PyList_Check(a));
     BoxedList* self = static_cast<BoxedList*>(a);
@@ -1077,6 +1040,25 @@ Box* listContains(BoxedList* self, Box* elt) {
     return boxBool(listContainsShared(self, elt));
 }
 
+// Versions of list_contains for exact int and str elements, which the compare IC calls directly.
+template <typename T> static int listContainsUnboxed(BoxedList* self, T* elt) noexcept {
+    // Comparing against elements of other classes can run arbitrary code that changes the list.
+    for (int i = 0; i < self->size; i++) {
+        int r = containsEltEq(elt, self->elts->elts[i]);
+        if (r)
+            return r;
+    }
+    return 0;
+}
+
+extern "C" int listContainsIntCapi(BoxedList* self, BoxedInt* elt) noexcept {
+    return listContainsUnboxed(self, elt);
+}
+
+extern "C" int listContainsStrCapi(BoxedList* self, BoxedString* elt) noexcept {
+    return listContainsUnboxed(self, elt);
+}
+
 Box* listCount(BoxedList* self, Box* elt) {
     int size = self->size;
     int count = 0;
@@ -1445,7 +1427,7 @@ PyDoc_STRVAR(sort_doc, "L.sort(cmp=None, key=None, reverse=False) -- stable sort
 cmp(x, y) -> -1, 0, 1");
 
 static PyMethodDef list_methods[]
-    = { { "sort", (PyCFunction)listsort, METH_VARARGS | METH_KEYWORDS, sort_doc }, { NULL, NULL, 0, NULL } };
+    = { { "sort", (PyCFunction)listsort, METH_FASTCALL | METH_KEYWORDS, sort_doc }, { NULL, NULL, 0, NULL } };
 
 void setupList() {
     static PySequenceMethods list_as_sequence;
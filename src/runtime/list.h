@@ -52,6 +52,10 @@ llvm_compat_bool listreviterHasnextUnboxed(Box* self);
 Box* listreviterNext(Box* self);
 Box* listreviter_next(Box* s) noexcept;
 extern "C" Box* listAppend(Box* self, Box* v);
+extern "C" Box* listGetitemUnboxedCapi(BoxedList* self, int64_t n) noexcept;
+extern "C" int listSetitemUnboxedCapi(BoxedList* self, int64_t n, Box* v) noexcept;
+extern "C" int listContainsIntCapi(BoxedList* self, BoxedInt* elt) noexcept;
+extern "C" int listContainsStrCapi(BoxedList* self, BoxedString* elt) noexcept;
 }
 
 #endif
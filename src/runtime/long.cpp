@@ -64,10 +64,106 @@ int _PyLong_DigitValue[256] = {
 #define PY_ABS_LLONG_MIN (0 - (unsigned PY_LONG_LONG)PY_LLONG_MIN)
 
 void BoxedLong::tp_dealloc(Box* b) noexcept {
-    mpz_clear(static_cast<BoxedLong*>(b)->n);
+    BoxedLong* l = static_cast<BoxedLong*>(b);
+    if (l->n->_mp_d != l->small_limbs)
+        mpz_clear(l->n);
     b->cls->tp_free(b);
 }
 
+// Small-value fast paths: when both operands are in (-2**127, 2**127) and the result fits in an __int128, we
+// compute it directly instead of calling into GMP, and store the result's limbs inline in the BoxedLong (see
+// BoxedLong::small_limbs) so that creating it doesn't need a GMP allocation either.  This is aimed at values
+// that just overflowed an int, such as the intermediates of hash or id computations; results computed by GMP
+// keep using GMP-allocated limbs, even when they would fit.
+static_assert(GMP_NUMB_BITS == 64 && GMP_NAIL_BITS == 0, "the small-long fast paths assume 64-bit limbs");
+
+static inline bool longGetSmall(BoxedLong* v, __int128* out) {
+    int size = v->n->_mp_size;
+    const mp_limb_t* d = v->n->_mp_d;
+    unsigned __int128 mag;
+    if (size == 0) {
+        *out = 0;
+        return true;
+    } else if (size == 1 || size == -1) {
+        mag = d[0];
+    } else if ((size == 2 || size == -2) && !(d[1] >> 63)) {
+        mag = ((unsigned __int128)d[1] << 64) | d[0];
+    } else {
+        return false;
+    }
+    *out = size < 0 ? -(__int128)mag : (__int128)mag;
+    return true;
+}
+
+// Like longGetSmall, but for the right-hand operand of a binary operation, which can also be an int.
+static inline bool longGetSmallOperand(Box* v, __int128* out) {
+    if (PyLong_Check(v))
+        return longGetSmall(static_cast<BoxedLong*>(v), out);
+    if (PyInt_Check(v)) {
+        *out = static_cast<BoxedInt*>(v)->n;
+        return true;
+    }
+    return false;
+}
+
+static BoxedLong* boxLongSmall(__int128 v) {
+    BoxedLong* rtn = new BoxedLong();
+    unsigned __int128 mag = v < 0 ? -(unsigned __int128)v : (unsigned __int128)v;
+    rtn->small_limbs[0] = (mp_limb_t)mag;
+    rtn->small_limbs[1] = (mp_limb_t)(mag >> 64);
+    int size = rtn->small_limbs[1] ? 2 : (rtn->small_limbs[0] ? 1 : 0);
+    rtn->n->_mp_alloc = 2;
+    rtn->n->_mp_size = v < 0 ? -size : size;
+    rtn->n->_mp_d = rtn->small_limbs;
+    return rtn;
+}
+
+// Number of significant bits in abs(v).
+static inline int smallBitLength(__int128 v) {
+    unsigned __int128 mag = v < 0 ? -(unsigned __int128)v : (unsigned __int128)v;
+    uint64_t hi = (uint64_t)(mag >> 64), lo = (uint64_t)mag;
+    if (hi)
+        return 128 - __builtin_clzll(hi);
+    return lo ? 64 - __builtin_clzll(lo) : 0;
+}
+
+// The following return false if the result doesn't fit, in which case the caller should fall back to GMP.
+static inline bool smallAdd(__int128 a, __int128 b, __int128* r) {
+    *r = (__int128)((unsigned __int128)a + (unsigned __int128)b);
+    return ((a ^ *r) & (b ^ *r)) >= 0;
+}
+
+static inline bool smallSub(__int128 a, __int128 b, __int128* r) {
+    *r = (__int128)((unsigned __int128)a - (unsigned __int128)b);
+    return ((a ^ b) & (a ^ *r)) >= 0;
+}
+
+static inline bool smallMul(__int128 a, __int128 b, __int128* r) {
+    if (smallBitLength(a) + smallBitLength(b) > 127)
+        return false;
+    *r = a * b;
+    return true;
+}
+
+// Python's division and modulo round towards negative infinity, C's towards zero.
+static inline bool smallFloorDiv(__int128 a, __int128 b, __int128* r) {
+    if (b == 0)
+        return false;
+    *r = a / b;
+    if (a % b != 0 && ((a < 0) != (b < 0)))
+        --*r;
+    return true;
+}
+
+static inline bool smallFloorMod(__int128 a, __int128 b, __int128* r) {
+    if (b == 0)
+        return false;
+    *r = a % b;
+    if (*r != 0 && ((*r < 0) != (b < 0)))
+        *r += b;
+    return true;
+}
+
 extern "C" int _PyLong_Sign(PyObject* l) noexcept {
     return mpz_sgn(static_cast<BoxedLong*>(l)->n);
 }
@@ -428,9 +524,7 @@ extern "C" PyObject* PyLong_FromDouble(double v) noexcept {
 }
 
 extern "C" PyObject* PyLong_FromLong(long ival) noexcept {
-    BoxedLong* rtn = new BoxedLong();
-    mpz_init_set_si(rtn->n, ival);
-    return rtn;
+    return boxLongSmall(ival);
 }
 
 #ifdef Py_USING_UNICODE
@@ -452,21 +546,15 @@ extern "C" PyObject* PyLong_FromUnicode(Py_UNICODE* u, Py_ssize_t length, int ba
 #endif
 
 extern "C" PyObject* PyLong_FromUnsignedLong(unsigned long ival) noexcept {
-    BoxedLong* rtn = new BoxedLong();
-    mpz_init_set_ui(rtn->n, ival);
-    return rtn;
+    return boxLongSmall(ival);
 }
 
 extern "C" PyObject* PyLong_FromSsize_t(Py_ssize_t ival) noexcept {
-    Py_ssize_t bytes = ival;
-    int one = 1;
-    return _PyLong_FromByteArray((unsigned char*)&bytes, SIZEOF_SIZE_T, IS_LITTLE_ENDIAN, 1);
+    return boxLongSmall(ival);
 }
 
 extern "C" PyObject* PyLong_FromSize_t(size_t ival) noexcept {
-    size_t bytes = ival;
-    int one = 1;
-    return _PyLong_FromByteArray((unsigned char*)&bytes, SIZEOF_SIZE_T, IS_LITTLE_ENDIAN, 0);
+    return boxLongSmall(ival);
 }
 
 #undef IS_LITTLE_ENDIAN
@@ -650,21 +738,15 @@ extern "C" Box* createLong(llvm::StringRef s) {
 }
 
 extern "C" BoxedLong* boxLong(int64_t n) {
-    BoxedLong* rtn = new BoxedLong();
-    mpz_init_set_si(rtn->n, n);
-    return rtn;
+    return boxLongSmall(n);
 }
 
 extern "C" PyObject* PyLong_FromLongLong(long long ival) noexcept {
-    BoxedLong* rtn = new BoxedLong();
-    mpz_init_set_si(rtn->n, ival);
-    return rtn;
+    return boxLongSmall(ival);
 }
 
 extern "C" PyObject* PyLong_FromUnsignedLongLong(unsigned long long ival) noexcept {
-    BoxedLong* rtn = new BoxedLong();
-    mpz_init_set_ui(rtn->n, ival);
-    return rtn;
+    return boxLongSmall(ival);
 }
 
 template <ExceptionStyle S> Box* _longNew(Box* val, Box* _base) noexcept(S == CAPI) {
@@ -895,6 +977,10 @@ Box* longNeg(BoxedLong* v1) {
     if (!PyLong_Check(v1))
         raiseExcHelper(TypeError, "descriptor '__neg__' requires a 'long' object but received a '%s'", getTypeName(v1));
 
+    __int128 a;
+    if (longGetSmall(v1, &a))
+        return boxLongSmall(-a);
+
     BoxedLong* r = new BoxedLong();
     mpz_init(r->n);
     mpz_neg(r->n, v1->n);
@@ -916,6 +1002,11 @@ Box* longPos(BoxedLong* v) {
 
 Box* longAbs(BoxedLong* v1) {
     assert(PyLong_Check(v1));
+
+    __int128 a;
+    if (longGetSmall(v1, &a))
+        return boxLongSmall(a < 0 ? -a : a);
+
     BoxedLong* r = new BoxedLong();
     mpz_init(r->n);
     mpz_abs(r->n, v1->n);
@@ -926,6 +1017,10 @@ Box* longAdd(BoxedLong* v1, Box* _v2) {
     if (!PyLong_Check(v1))
         raiseExcHelper(TypeError, "descriptor '__add__' requires a 'long' object but received a '%s'", getTypeName(v1));
 
+    __int128 a, b, c;
+    if (longGetSmall(v1, &a) && longGetSmallOperand(_v2, &b) && smallAdd(a, b, &c))
+        return boxLongSmall(c);
+
     if (PyLong_Check(_v2)) {
         BoxedLong* v2 = static_cast<BoxedLong*>(_v2);
 
@@ -952,6 +1047,11 @@ Box* longAdd(BoxedLong* v1, Box* _v2) {
 extern "C" Box* longAnd(BoxedLong* v1, Box* _v2) {
     if (!PyLong_Check(v1))
         raiseExcHelper(TypeError, "descriptor '__and__' requires a 'long' object but received a '%s'", getTypeName(v1));
+
+    __int128 a, b;
+    if (longGetSmall(v1, &a) && longGetSmallOperand(_v2, &b))
+        return boxLongSmall(a & b);
+
     if (PyLong_Check(_v2)) {
         BoxedLong* v2 = static_cast<BoxedLong*>(_v2);
         BoxedLong* r = new BoxedLong();
@@ -978,6 +1078,11 @@ extern "C" Box* longAnd(BoxedLong* v1, Box* _v2) {
 extern "C" Box* longOr(BoxedLong* v1, Box* _v2) {
     if (!PyLong_Check(v1))
         raiseExcHelper(TypeError, "descriptor '__or__' requires a 'long' object but received a '%s'", getTypeName(v1));
+
+    __int128 a, b;
+    if (longGetSmall(v1, &a) && longGetSmallOperand(_v2, &b))
+        return boxLongSmall(a | b);
+
     if (PyLong_Check(_v2)) {
         BoxedLong* v2 = static_cast<BoxedLong*>(_v2);
         BoxedLong* r = new BoxedLong();
@@ -1004,6 +1109,11 @@ extern "C" Box* longOr(BoxedLong* v1, Box* _v2) {
 extern "C" Box* longXor(BoxedLong* v1, Box* _v2) {
     if (!PyLong_Check(v1))
         raiseExcHelper(TypeError, "descriptor '__xor__' requires a 'long' object but received a '%s'", getTypeName(v1));
+
+    __int128 a, b;
+    if (longGetSmall(v1, &a) && longGetSmallOperand(_v2, &b))
+        return boxLongSmall(a ^ b);
+
     if (PyLong_Check(_v2)) {
         BoxedLong* v2 = static_cast<BoxedLong*>(_v2);
         BoxedLong* r = new BoxedLong();
@@ -1073,6 +1183,11 @@ Box* longLShiftLong(BoxedLong* lhs, Box* _rhs) {
         raiseExcHelper(ValueError, "negative shift count");
 
     uint64_t n = asUnsignedLong(rhs_long);
+
+    __int128 a;
+    if (n < 127 && longGetSmall(lhs, &a) && smallBitLength(a) + n <= 127)
+        return boxLongSmall(a * ((__int128)1 << n));
+
     BoxedLong* r = new BoxedLong();
     mpz_init(r->n);
     mpz_mul_2exp(r->n, lhs->n, n);
@@ -1116,6 +1231,11 @@ Box* longRShiftLong(BoxedLong* lhs, Box* _rhs) {
         raiseExcHelper(ValueError, "negative shift count");
 
     uint64_t n = asUnsignedLong(rhs_long);
+
+    __int128 a;
+    if (longGetSmall(lhs, &a))
+        return boxLongSmall(n < 127 ? a >> n : (a < 0 ? -1 : 0));
+
     BoxedLong* r = new BoxedLong();
     mpz_init(r->n);
     mpz_div_2exp(r->n, lhs->n, n);
@@ -1165,6 +1285,10 @@ Box* longSub(BoxedLong* v1, Box* _v2) {
     if (!PyLong_Check(v1))
         raiseExcHelper(TypeError, "descriptor '__sub__' requires a 'long' object but received a '%s'", getTypeName(v1));
 
+    __int128 a, b, c;
+    if (longGetSmall(v1, &a) && longGetSmallOperand(_v2, &b) && smallSub(a, b, &c))
+        return boxLongSmall(c);
+
     if (PyLong_Check(_v2)) {
         BoxedLong* v2 = static_cast<BoxedLong*>(_v2);
 
@@ -1199,6 +1323,10 @@ Box* longMul(BoxedLong* v1, Box* _v2) {
     if (!PyLong_Check(v1))
         raiseExcHelper(TypeError, "descriptor '__mul__' requires a 'long' object but received a '%s'", getTypeName(v1));
 
+    __int128 a, b, c;
+    if (longGetSmall(v1, &a) && longGetSmallOperand(_v2, &b) && smallMul(a, b, &c))
+        return boxLongSmall(c);
+
     if (PyLong_Check(_v2)) {
         BoxedLong* v2 = static_cast<BoxedLong*>(_v2);
 
@@ -1222,6 +1350,10 @@ Box* longDiv(BoxedLong* v1, Box* _v2) {
     if (!PyLong_Check(v1))
         raiseExcHelper(TypeError, "descriptor '__div__' requires a 'long' object but received a '%s'", getTypeName(v1));
 
+    __int128 a, b, c;
+    if (longGetSmall(v1, &a) && longGetSmallOperand(_v2, &b) && smallFloorDiv(a, b, &c))
+        return boxLongSmall(c);
+
     if (PyLong_Check(_v2)) {
         BoxedLong* v2 = static_cast<BoxedLong*>(_v2);
 
@@ -1258,6 +1390,10 @@ Box* longMod(BoxedLong* v1, Box* _v2) {
     if (!PyLong_Check(v1))
         raiseExcHelper(TypeError, "descriptor '__mod__' requires a 'long' object but received a '%s'", getTypeName(v1));
 
+    __int128 a, b, c;
+    if (longGetSmall(v1, &a) && longGetSmallOperand(_v2, &b) && smallFloorMod(a, b, &c))
+        return boxLongSmall(c);
+
     if (PyLong_Check(_v2)) {
         BoxedLong* v2 = static_cast<BoxedLong*>(_v2);
 
@@ -1559,6 +1695,10 @@ extern "C" Box* longInvert(BoxedLong* v) {
         raiseExcHelper(TypeError, "descriptor '__invert__' requires a 'long' object but received a '%s'",
                        getTypeName(v));
 
+    __int128 a;
+    if (longGetSmall(v, &a))
+        return boxLongSmall(~a);
+
     BoxedLong* r = new BoxedLong();
     mpz_init(r->n);
     mpz_com(r->n, v->n);
@@ -31,6 +31,11 @@ class BoxedLong : public Box {
 public:
     mpz_t n;
 
+    // Longs created by the small-value fast paths in long.cpp store their limbs here rather than in memory
+    // allocated by GMP, with n._mp_d pointing at this array.  This is safe because longs are immutable: n is
+    // only ever used as a source operand once the object has been created, so GMP never needs to grow or free it.
+    mp_limb_t small_limbs[2];
+
     BoxedLong() __attribute__((visibility("default"))) {}
 
     static void tp_dealloc(Box* b) noexcept;
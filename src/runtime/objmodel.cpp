@@ -45,8 +45,12 @@
 #include "runtime/ics.h"
 #include "runtime/import.h"
 #include "runtime/iterobject.h"
+#include "runtime/list.h"
 #include "runtime/long.h"
 #include "runtime/rewrite_args.h"
+#include "runtime/set.h"
+#include "runtime/super.h"
+#include "runtime/tuple.h"
 #include "runtime/types.h"
 #include "runtime/util.h"
 
@@ -1183,6 +1187,10 @@ template Box* Box::getattr<NOT_REWRITABLE>(BoxedString*, GetattrRewriteArgs*);
 // overhead, so the resulting size might not end up fitting that efficiently.
 #define INITIAL_ARRAY_SIZE 4
 
+// Upper bound on BoxedClass::instance_inline_attrs, ie on the number of attribute slots that get allocated inside
+// each instance.  Objects that grow past their inline slots move to a separately-allocated array.
+#define MAX_INLINE_ATTRS 16
+
 // Freelist for attribute arrays.  Parameters have not been tuned.
 #define ARRAYLIST_FREELIST_SIZE 100
 #define ARRAYLIST_NUM_FREELISTS 4
@@ -1226,11 +1234,14 @@ static HCAttrs::AttrList* allocFromFreelist(int freelist_idx) {
         int nattrs = (1 << freelist_idx) * INITIAL_ARRAY_SIZE;
         memset(rtn, 0xcb, sizeof(HCAttrs::AttrList) + nattrs * sizeof(Box*));
 #endif
+        rtn->inline_capacity = 0;
         return rtn;
     }
 
     int nattrs = (1 << freelist_idx) * INITIAL_ARRAY_SIZE;
-    return (HCAttrs::AttrList*)PyObject_MALLOC(sizeof(HCAttrs::AttrList) + nattrs * sizeof(Box*));
+    auto rtn = (HCAttrs::AttrList*)PyObject_MALLOC(sizeof(HCAttrs::AttrList) + nattrs * sizeof(Box*));
+    rtn->inline_capacity = 0;
+    return rtn;
 }
 
 static HCAttrs::AttrList* allocAttrs(int nattrs) {
@@ -1239,10 +1250,14 @@ static HCAttrs::AttrList* allocAttrs(int nattrs) {
     if (nattrs <= MAX_FREELIST_SIZE)
         return allocFromFreelist(freelistIndex(nattrs));
 
-    return (HCAttrs::AttrList*)PyObject_MALLOC(sizeof(HCAttrs::AttrList) + nattrs * sizeof(Box*));
+    auto rtn = (HCAttrs::AttrList*)PyObject_MALLOC(sizeof(HCAttrs::AttrList) + nattrs * sizeof(Box*));
+    rtn->inline_capacity = 0;
+    return rtn;
 }
 
 static void freeAttrs(HCAttrs::AttrList* attrs, int nattrs) {
+    assert(!attrs->inline_capacity);
+
     if (nattrs <= MAX_FREELIST_SIZE) {
         int idx = freelistIndex(nattrs);
         auto&& freelist = attrlist_freelist[idx];
@@ -1269,6 +1284,7 @@ static void freeAttrs(HCAttrs::AttrList* attrs, int nattrs) {
 static HCAttrs::AttrList* reallocAttrs(HCAttrs::AttrList* attrs, int old_nattrs, int new_nattrs) {
     assert(arrayIsAtCapacity(old_nattrs));
     assert(new_nattrs > old_nattrs);
+    assert(!attrs->inline_capacity);
 
     HCAttrs::AttrList* rtn = allocAttrs(new_nattrs);
     memcpy(rtn, attrs, sizeof(HCAttrs::AttrList) + sizeof(Box*) * old_nattrs);
@@ -1280,6 +1296,26 @@ static HCAttrs::AttrList* reallocAttrs(HCAttrs::AttrList* attrs, int old_nattrs,
     return rtn;
 }
 
+// Called when an inline attribute array (see PyType_GenericAlloc) is full: returns a separately-allocated copy with
+// room for at least one more attribute.  The inline array is part of its object, so there's nothing to free.
+static HCAttrs::AttrList* moveInlineAttrs(HCAttrs::AttrList* attrs, int nattrs) {
+    assert(attrs->inline_capacity == nattrs);
+
+    int new_size = INITIAL_ARRAY_SIZE;
+    while (new_size <= nattrs)
+        new_size *= 2;
+
+    HCAttrs::AttrList* rtn = allocAttrs(new_size);
+    memcpy(rtn->attrs, attrs->attrs, sizeof(Box*) * nattrs);
+    return rtn;
+}
+
+// Frees an attribute array, unless it's stored inline in its object.
+static void freeAttrsIfNotInline(HCAttrs::AttrList* attrs, int nattrs) {
+    if (!attrs->inline_capacity)
+        freeAttrs(attrs, nattrs);
+}
+
 void Box::setDictBacked(STOLEN(Box*) val) {
     // this checks for: v.__dict__ = v.__dict__
     if (val->cls == attrwrapper_cls && unwrapAttrWrapper(val) == this) {
@@ -1317,6 +1353,7 @@ void Box::setDictBacked(STOLEN(Box*) val) {
     // assign the dict to the attribute list and switch to the dict backed strategy
     // Skips the attrlist freelist
     auto new_attr_list = (HCAttrs::AttrList*)PyObject_MALLOC(sizeof(HCAttrs::AttrList) + sizeof(Box*));
+    new_attr_list->inline_capacity = 0;
     new_attr_list->attrs[0] = val;
 
     auto old_attr_list = hcattrs->attr_list;
@@ -1325,10 +1362,11 @@ void Box::setDictBacked(STOLEN(Box*) val) {
     hcattrs->hcls = HiddenClass::dict_backed;
     hcattrs->attr_list = new_attr_list;
 
-    assert((bool)old_attr_list == (bool)old_attr_list_size);
+    // An empty array is possible if it is stored inline
+    assert(old_attr_list || !old_attr_list_size);
     if (old_attr_list_size) {
         decrefArray(old_attr_list->attrs, old_attr_list_size);
-        freeAttrs(old_attr_list, old_attr_list_size);
+        freeAttrsIfNotInline(old_attr_list, old_attr_list_size);
     }
 }
 
@@ -1354,6 +1392,8 @@ void HCAttrs::_clearRaw() noexcept {
         // DICT_BACKED attrs don't use the freelist:
         if (hcls->type == HiddenClass::DICT_BACKED)
             PyObject_FREE(old_attr_list);
+        else if (old_attr_list->inline_capacity)
+            this->attr_list = old_attr_list; // keep the inline slots around for any new attributes
         else
             freeAttrs(old_attr_list, old_attr_list_size);
     }
@@ -1438,8 +1478,43 @@ void Box::appendNewHCAttr(BORROWED(Box*) new_attr, SetattrRewriteArgs* rewrite_a
 
     int numattrs = hcls->attributeArraySize();
 
+    // Instances of heap types can have their attribute array allocated inline, after the end of the object (see
+    // PyType_GenericAlloc).  Remember how many attributes instances of this class end up with, so that future
+    // instances get enough inline slots for them.
+    if ((cls->tp_flags & Py_TPFLAGS_HEAPTYPE) && cls->attrs_offset > 0 && cls->tp_itemsize == 0
+        && numattrs + 1 > cls->instance_inline_attrs)
+        cls->instance_inline_attrs = std::min(numattrs + 1, MAX_INLINE_ATTRS);
+
+    HCAttrs::AttrList* attr_list = attrs->attr_list;
+    int inline_capacity = attr_list ? attr_list->inline_capacity : 0;
+
+    // Whether the array is inline (and how many slots it has) is a property of the object rather than of its hidden
+    // class, so the rewrite has to guard on it:
+    RewriterVar* r_oldarray = NULL;
+    if (rewrite_args) {
+        if (cls->attrs_offset < 0) {
+            REWRITE_ABORTED("");
+            rewrite_args = NULL;
+        } else if (!attr_list) {
+            assert(numattrs == 0);
+            rewrite_args->obj->addAttrGuard(cls->attrs_offset + offsetof(HCAttrs, attr_list), 0);
+        } else {
+            r_oldarray = rewrite_args->obj->getAttr(cls->attrs_offset + offsetof(HCAttrs, attr_list),
+                                                    Location::forArg(0));
+            r_oldarray->addAttrGuard(offsetof(HCAttrs::AttrList, inline_capacity), inline_capacity);
+        }
+    }
+
     RewriterVar* r_array = NULL;
-    if (numattrs == 0 || arrayIsAtCapacity(numattrs)) {
+    if (inline_capacity) {
+        if (numattrs == inline_capacity) {
+            attrs->attr_list = moveInlineAttrs(attr_list, numattrs);
+            if (rewrite_args) {
+                RewriterVar* r_oldsize = rewrite_args->rewriter->loadConst(numattrs, Location::forArg(1));
+                r_array = rewrite_args->rewriter->call(true, (void*)moveInlineAttrs, r_oldarray, r_oldsize);
+            }
+        }
+    } else if (numattrs == 0 || arrayIsAtCapacity(numattrs)) {
         if (numattrs == 0) {
             attrs->attr_list = allocFromFreelist(0);
             if (rewrite_args) {
@@ -1450,16 +1525,9 @@ void Box::appendNewHCAttr(BORROWED(Box*) new_attr, SetattrRewriteArgs* rewrite_a
             int new_size = nextAttributeArraySize(numattrs);
             attrs->attr_list = (HCAttrs::AttrList*)reallocAttrs(attrs->attr_list, numattrs, new_size);
             if (rewrite_args) {
-                if (cls->attrs_offset < 0) {
-                    REWRITE_ABORTED("");
-                    rewrite_args = NULL;
-                } else {
-                    RewriterVar* r_oldarray = rewrite_args->obj->getAttr(
-                        cls->attrs_offset + offsetof(HCAttrs, attr_list), Location::forArg(0));
-                    RewriterVar* r_oldsize = rewrite_args->rewriter->loadConst(numattrs, Location::forArg(1));
-                    RewriterVar* r_newsize = rewrite_args->rewriter->loadConst(new_size, Location::forArg(2));
-                    r_array = rewrite_args->rewriter->call(true, (void*)reallocAttrs, r_oldarray, r_oldsize, r_newsize);
-                }
+                RewriterVar* r_oldsize = rewrite_args->rewriter->loadConst(numattrs, Location::forArg(1));
+                RewriterVar* r_newsize = rewrite_args->rewriter->loadConst(new_size, Location::forArg(2));
+                r_array = rewrite_args->rewriter->call(true, (void*)reallocAttrs, r_oldarray, r_oldsize, r_newsize);
             }
         }
     }
@@ -1468,7 +1536,7 @@ void Box::appendNewHCAttr(BORROWED(Box*) new_attr, SetattrRewriteArgs* rewrite_a
         bool new_array = (bool)r_array;
 
         if (!new_array)
-            r_array = rewrite_args->obj->getAttr(cls->attrs_offset + offsetof(HCAttrs, attr_list));
+            r_array = r_oldarray;
 
         r_array->setAttr(numattrs * sizeof(Box*) + offsetof(HCAttrs::AttrList, attrs), rewrite_args->attrval,
                          RewriterVar::SetattrType::HANDED_OFF);
@@ -1661,6 +1729,8 @@ extern "C" unsigned int PyType_ClearCache() noexcept {
     /* mark all version tags as invalid */
     PyType_Modified(&PyBaseObject_Type);
     is_wrap_around = false;
+    // Pyston addition: version tags will get reused, so this cache has to go too
+    clearTypecheckCache();
     return cur_version_tag;
 }
 
@@ -1699,6 +1769,7 @@ int assign_version_tag(PyTypeObject* type) noexcept {
             method_cache[i].name = Py_None;
             Py_INCREF(Py_None);
         }
+        clearTypecheckCache(); // Pyston addition
         /* mark all version tags as invalid */
         PyType_Modified(&PyBaseObject_Type);
         return 1;
@@ -2035,6 +2106,19 @@ Box* boxChar(char c) {
     return boxString(llvm::StringRef(d, 1));
 }
 
+// Defined in operator.c
+extern "C" int _PyOperator_GetItemgetterIndex(PyObject* f, Py_ssize_t* index) noexcept;
+
+// Whether subscripting an instance of cls (a tuple subclass) ends up in tuple's own __getitem__.
+// Only answered for classes with version tags, since that's what lets the getattr IC (which guards on the
+// version tag in typeLookup) rely on the answer staying the same.
+static bool usesTupleGetitem(BoxedClass* cls) {
+    static BoxedString* getitem_str = getStaticString("__getitem__");
+    if (!PyType_HasFeature(cls, Py_TPFLAGS_HAVE_VERSION_TAG))
+        return false;
+    return cls == tuple_cls || typeLookup(cls, getitem_str) == typeLookup(tuple_cls, getitem_str);
+}
+
 // r_descr needs to represent a valid object
 template <Rewritable rewritable>
 Box* dataDescriptorInstanceSpecialCases(GetattrRewriteArgs* rewrite_args, BoxedString* attr_name, Box* obj, Box* descr,
@@ -2051,7 +2135,13 @@ Box* dataDescriptorInstanceSpecialCases(GetattrRewriteArgs* rewrite_args, BoxedS
         slowpath.log();
 
         PyMemberDescrObject* member_desc = reinterpret_cast<PyMemberDescrObject*>(descr);
-        // TODO should also have logic to raise a type error if type of obj is wrong
+
+        // The IC has guarded on the class of obj, so this check doesn't need to be emitted:
+        if (!PyObject_TypeCheck(obj, member_desc->d_type)) {
+            assert(attr_name->data()[attr_name->size()] == '\0');
+            raiseExcHelper(TypeError, "descriptor '%s' for '%s' objects doesn't apply to '%s' object",
+                           attr_name->data(), member_desc->d_type->tp_name, getTypeName(obj));
+        }
 
         if (rewrite_args) {
             // TODO we could use offset as the index in the assembly lookup rather than hardcoding
@@ -2195,6 +2285,25 @@ Box* dataDescriptorInstanceSpecialCases(GetattrRewriteArgs* rewrite_args, BoxedS
             raiseExcHelper(AttributeError, "unreadable attribute");
         }
 
+        // namedtuple fields are properties whose getter is an itemgetter with a constant index.
+        // Read the element straight out of the tuple rather than calling the itemgetter:
+        Py_ssize_t index;
+        if (PyTuple_Check(obj) && _PyOperator_GetItemgetterIndex(prop->prop_get, &index)
+            && index < PyTuple_GET_SIZE(obj) && usesTupleGetitem(obj->cls)) {
+            static StatCounter num_itemgetter_fastpath("num_property_itemgetter_fastpath");
+            num_itemgetter_fastpath.log();
+
+            BoxedTuple* tuple = static_cast<BoxedTuple*>(obj);
+            if (rewrite_args) {
+                r_descr->addAttrGuard(offsetof(BoxedProperty, prop_get), (intptr_t)prop->prop_get);
+                rewrite_args->obj->addAttrGuard(offsetof(BoxedTuple, ob_size), tuple->size());
+                RewriterVar* r_rtn = rewrite_args->obj->getAttr(offsetof(BoxedTuple, elts) + index * sizeof(Box*),
+                                                                rewrite_args->destination)->setType(RefType::BORROWED);
+                rewrite_args->setReturn(r_rtn, ReturnConvention::HAS_RETURN);
+            }
+            return incref(tuple->elts[index]);
+        }
+
         if (rewrite_args) {
             r_descr->addAttrGuard(offsetof(BoxedProperty, prop_get), (intptr_t)prop->prop_get);
 
@@ -2281,7 +2390,10 @@ Box* getattrInternalEx(Box* obj, BoxedString* attr, GetattrRewriteArgs* rewrite_
                 return slotTpGetattrHookInternal<S, rewritable>(obj, attr, rewrite_args, for_call, bind_obj_out,
                                                                 r_bind_obj_out);
             } else if (obj->cls->tp_getattro == instance_getattro) {
-                return instanceGetattroInternal<S>(obj, attr, rewrite_args);
+                return instanceGetattroInternal<S>(obj, attr, rewrite_args, for_call, bind_obj_out,
+                                                   r_bind_obj_out);
+            } else if (obj->cls->tp_getattro == super_getattro) {
+                return superGetattroInternal<S>(obj, attr, rewrite_args, for_call, bind_obj_out, r_bind_obj_out);
             } else if (obj->cls->tp_getattro == type_getattro) {
                 try {
                     Box* r = getattrInternalGeneric<true, rewritable>(obj, attr, rewrite_args, cls_only, for_call,
@@ -2999,7 +3111,27 @@ bool dataDescriptorSetSpecialCases(Box* obj, STOLEN(Box*) val, Box* descr, Setat
         return true;
     } else if (descr->cls == &PyMemberDescr_Type) {
         PyMemberDescrObject* member_desc = reinterpret_cast<PyMemberDescrObject*>(descr);
-        int ret = PyMember_SetOne((char*)obj, member_desc->d_member, val);
+        PyMemberDef* member = member_desc->d_member;
+
+        if (!PyObject_TypeCheck(obj, member_desc->d_type)) {
+            assert(attr_name->data()[attr_name->size()] == '\0');
+            Py_DECREF(val);
+            raiseExcHelper(TypeError, "descriptor '%s' for '%s' objects doesn't apply to '%s' object",
+                           attr_name->data(), member_desc->d_type->tp_name, getTypeName(obj));
+        }
+
+        // Object members (which is what __slots__ creates) get stored directly into the object.  The IC has
+        // guarded on the class of obj, so the type check above doesn't need to be emitted.
+        if (rewrite_args && (member->type == T_OBJECT || member->type == T_OBJECT_EX) && member->flags == 0) {
+            static StatCounter member_set_rewritten("num_member_descriptor_set_rewritten");
+            member_set_rewritten.log();
+
+            r_descr->addAttrGuard(offsetof(PyMemberDescrObject, d_member), (intptr_t)member);
+            rewrite_args->obj->replaceAttr(member->offset, rewrite_args->attrval, /* prev_nullable */ true);
+            rewrite_args->out_success = true;
+        }
+
+        int ret = PyMember_SetOne((char*)obj, member, val);
         Py_DECREF(val);
         if (ret < 0)
             throwCAPIException();
@@ -4069,11 +4201,10 @@ public:
         }
     }
 };
-static int placeKeyword(const ParamNames* param_names, llvm::SmallVector<bool, 8>& params_filled, BoxedString* kw_name,
-                        Box* kw_val, Box*& oarg1, Box*& oarg2, Box*& oarg3, Box** oargs, BoxedDict* okwargs,
-                        FuncNameGetter func_name_cb) {
-    assert(kw_val);
-    assert(kw_name);
+// Returns the index of the normal parameter named kw_name, or -1 if there isn't one.
+static int findKeywordParam(const ParamNames* param_names, BoxedString* kw_name) {
+    if (kw_name->size() == 0)
+        return -1;
 
     for (int j = 0; j < param_names->numNormalArgs(); j++) {
         llvm::StringRef s;
@@ -4081,19 +4212,62 @@ static int placeKeyword(const ParamNames* param_names, llvm::SmallVector<bool, 8
             s = param_names->all_args[j].name->id.s();
         else
             s = param_names->all_args[j].str;
-        if (s == kw_name->s() && kw_name->size() > 0) {
-            if (params_filled[j]) {
-                raiseExcHelper(TypeError, "%.200s() got multiple values for keyword argument '%s'", func_name_cb(),
-                               kw_name->c_str());
-            }
-            getArg(j, oarg1, oarg2, oarg3, oargs) = incref(kw_val);
-            params_filled[j] = true;
+        if (s == kw_name->s())
             return j;
+    }
+    return -1;
+}
+
+// Returns the parameter index of every keyword passed by the call site, computing it the first time we see a
+// particular list of keyword names.  Returns NULL if the names aren't something we can cache.
+static const int* getKeywordBinding(const ParamNames* param_names, const std::vector<BoxedString*>* keyword_names) {
+    // Functions that are called with lots of different keyword combinations just get the uncached name search.
+    static const int MAX_KEYWORD_BINDINGS = 8;
+
+    for (auto&& b : param_names->keyword_bindings) {
+        if (b.keyword_names == *keyword_names)
+            return b.dests.data();
+    }
+
+    if (param_names->keyword_bindings.size() >= MAX_KEYWORD_BINDINGS)
+        return NULL;
+
+    for (BoxedString* kw_name : *keyword_names) {
+        if (kw_name->interned_state != SSTATE_INTERNED_IMMORTAL)
+            return NULL;
+    }
+
+    ParamNames::KeywordBinding binding;
+    binding.keyword_names = *keyword_names;
+    binding.dests.reserve(keyword_names->size());
+    for (BoxedString* kw_name : *keyword_names)
+        binding.dests.push_back(findKeywordParam(param_names, kw_name));
+
+    // Moving the vector keeps its buffer, so the returned pointer stays valid if more bindings get added later.
+    param_names->keyword_bindings.push_back(std::move(binding));
+    return param_names->keyword_bindings.back().dests.data();
+}
+
+// Stores kw_val as parameter j (as returned by findKeywordParam), or into okwargs if j is -1.
+static int placeKeywordAt(int j, llvm::SmallVector<bool, 8>& params_filled, BoxedString* kw_name, Box* kw_val,
+                          Box*& oarg1, Box*& oarg2, Box*& oarg3, Box** oargs, BoxedDict* okwargs,
+                          FuncNameGetter func_name_cb) {
+    assert(kw_val);
+    assert(kw_name);
+
+    if (j != -1) {
+        if (params_filled[j]) {
+            raiseExcHelper(TypeError, "%.200s() got multiple values for keyword argument '%s'", func_name_cb(),
+                           kw_name->c_str());
         }
+        getArg(j, oarg1, oarg2, oarg3, oargs) = incref(kw_val);
+        params_filled[j] = true;
+        return j;
     }
 
     if (okwargs) {
         Box*& v = okwargs->d[kw_name];
+        okwargs->keysChanged();
         if (v) {
             raiseExcHelper(TypeError, "%.200s() got multiple values for keyword argument '%s'", func_name_cb(),
                            kw_name->c_str());
@@ -4106,6 +4280,27 @@ static int placeKeyword(const ParamNames* param_names, llvm::SmallVector<bool, 8
     }
 }
 
+static int placeKeyword(const ParamNames* param_names, llvm::SmallVector<bool, 8>& params_filled, BoxedString* kw_name,
+                        Box* kw_val, Box*& oarg1, Box*& oarg2, Box*& oarg3, Box** oargs, BoxedDict* okwargs,
+                        FuncNameGetter func_name_cb) {
+    return placeKeywordAt(findKeywordParam(param_names, kw_name), params_filled, kw_name, kw_val, oarg1, oarg2, oarg3,
+                          oargs, okwargs, func_name_cb);
+}
+
+// Returns whether every entry of a **kwargs dict would end up in the callee's own **kwargs, ie all the keys are
+// strings that don't name a normal parameter.  If so the entries can be copied over in one go.
+static bool kwargsPassThrough(const ParamNames* param_names, BoxedDict* d_kwargs) {
+    bool check_names = param_names && param_names->takes_param_names;
+    for (auto&& p : d_kwargs->d) {
+        Box* k = p.first.value;
+        if (k->cls != str_cls)
+            return false;
+        if (check_names && findKeywordParam(param_names, static_cast<BoxedString*>(k)) != -1)
+            return false;
+    }
+    return true;
+}
+
 template <ExceptionStyle S>
 static Box* _callFuncHelper(BoxedFunctionBase* func, ArgPassSpec argspec, Box* arg1, Box* arg2, Box* arg3,
                             void** extra_args) {
@@ -4402,10 +4597,16 @@ Box* rearrangeArgumentsAndCallInternal(ParamReceiveSpec paramspec, const ParamNa
         }
 
         Box* ovarargs;
-        if (argspec.num_args == 0 && paramspec.num_args == 0 && (!varargs || varargs->cls == tuple_cls)) {
-            // We probably could have cut out a lot more of the overhead in this case:
+        if (positional_to_positional == argspec.num_args && varargs_to_positional == 0
+            && (!varargs || varargs->cls == tuple_cls)) {
+            // The incoming *args ends up as the outgoing one unchanged (the common case for wrappers that do
+            // `return f(*args, **kw)`), so pass the tuple through instead of copying it.
             assert(varargs_size == unused_positional.size());
 
+            static StatCounter num_varargs_passthrough("num_varargs_passthrough");
+            if (varargs)
+                num_varargs_passthrough.log();
+
             if (!varargs)
                 ovarargs = incref(EmptyTuple);
             else
@@ -4479,6 +4680,10 @@ Box* rearrangeArgumentsAndCallInternal(ParamReceiveSpec paramspec, const ParamNa
             }
         }
 
+        const int* keyword_dests = NULL;
+        if (param_names && param_names->takes_param_names)
+            keyword_dests = getKeywordBinding(param_names, keyword_names);
+
         BoxedDict* okwargs = get_okwargs();
         for (int i = 0; i < argspec.num_keywords; i++) {
             if (rewrite_args)
@@ -4490,11 +4695,17 @@ Box* rearrangeArgumentsAndCallInternal(ParamReceiveSpec paramspec, const ParamNa
             if (!param_names || !param_names->takes_param_names) {
                 assert(!rewrite_args); // would need to add it to r_kwargs
                 okwargs->d[incref((*keyword_names)[i])] = incref(kw_val);
+                okwargs->keysChanged();
                 continue;
             }
 
-            int dest = placeKeyword(param_names, params_filled, (*keyword_names)[i], kw_val, oarg1, oarg2, oarg3, oargs,
-                                    okwargs, func_name_cb);
+            int dest;
+            if (keyword_dests)
+                dest = placeKeywordAt(keyword_dests[i], params_filled, (*keyword_names)[i], kw_val, oarg1, oarg2,
+                                      oarg3, oargs, okwargs, func_name_cb);
+            else
+                dest = placeKeyword(param_names, params_filled, (*keyword_names)[i], kw_val, oarg1, oarg2, oarg3,
+                                    oargs, okwargs, func_name_cb);
             if (rewrite_args) {
                 assert(dest != -1);
                 if (dest == 0)
@@ -4515,6 +4726,8 @@ Box* rearrangeArgumentsAndCallInternal(ParamReceiveSpec paramspec, const ParamNa
         Box* kwargs
             = getArg(argspec.num_args + argspec.num_keywords + (argspec.has_starargs ? 1 : 0), arg1, arg2, arg3, args);
 
+        // Whether kwargs is a dict we created here, which nothing else can have a reference to.
+        bool kwargs_is_private = true;
         if (!kwargs) {
             // TODO could try to avoid creating this
             kwargs = new BoxedDict();
@@ -4524,45 +4737,61 @@ Box* rearrangeArgumentsAndCallInternal(ParamReceiveSpec paramspec, const ParamNa
             kwargs = d;
         } else {
             Py_INCREF(kwargs);
+            kwargs_is_private = false;
         }
         DecrefHandle<Box> _kwargs_handle(kwargs);
 
         assert(PyDict_Check(kwargs));
         BoxedDict* d_kwargs = static_cast<BoxedDict*>(kwargs);
 
-        BoxedDict* okwargs = NULL;
-        if (d_kwargs->d.size()) {
-            okwargs = get_okwargs();
+        // If the callee's **kwargs is going to end up with exactly the contents of d_kwargs (for example a wrapper
+        // doing `return f(*args, **kw)` into a function that also takes **kw), copy the dict in one go rather than
+        // inserting its entries one at a time.  We still have to make a copy, since the callee is allowed to
+        // modify its kwargs, unless the dict is one that we just created ourselves.
+        if (d_kwargs->d.size() && paramspec.takes_kwargs && !*_okwargs && kwargsPassThrough(param_names, d_kwargs)) {
+            static StatCounter num_kwargs_passthrough("num_kwargs_passthrough");
+            num_kwargs_passthrough.log();
 
-            if (!okwargs && (!param_names || !param_names->takes_param_names))
-                raiseExcHelper(TypeError, "%s() doesn't take keyword arguments", func_name_cb());
-        }
+            if (kwargs_is_private)
+                *_okwargs = static_cast<BoxedDict*>(incref(d_kwargs));
+            else
+                *_okwargs = static_cast<BoxedDict*>(dictCopy(d_kwargs));
+        } else {
+            BoxedDict* okwargs = NULL;
+            if (d_kwargs->d.size()) {
+                okwargs = get_okwargs();
 
-        for (const auto& p : *d_kwargs) {
-            auto k = coerceUnicodeToStr<CXX>(p.first);
-            AUTO_DECREF(k);
+                if (!okwargs && (!param_names || !param_names->takes_param_names))
+                    raiseExcHelper(TypeError, "%s() doesn't take keyword arguments", func_name_cb());
+            }
 
-            if (k->cls != str_cls)
-                raiseExcHelper(TypeError, "%s() keywords must be strings", func_name_cb());
+            for (const auto& p : *d_kwargs) {
+                auto k = coerceUnicodeToStr<CXX>(p.first);
+                AUTO_DECREF(k);
 
-            BoxedString* s = static_cast<BoxedString*>(k);
+                if (k->cls != str_cls)
+                    raiseExcHelper(TypeError, "%s() keywords must be strings", func_name_cb());
 
-            if (param_names && param_names->takes_param_names) {
-                assert(!rewrite_args && "would need to make sure that this didn't need to go into r_kwargs");
-                placeKeyword(param_names, params_filled, s, p.second, oarg1, oarg2, oarg3, oargs, okwargs,
-                             func_name_cb);
-            } else {
-                assert(!rewrite_args && "would need to make sure that this didn't need to go into r_kwargs");
-                assert(okwargs);
+                BoxedString* s = static_cast<BoxedString*>(k);
 
-                Box*& v = okwargs->d[p.first];
-                if (v) {
-                    raiseExcHelper(TypeError, "%s() got multiple values for keyword argument '%s'", func_name_cb(),
-                                   s->data());
+                if (param_names && param_names->takes_param_names) {
+                    assert(!rewrite_args && "would need to make sure that this didn't need to go into r_kwargs");
+                    placeKeyword(param_names, params_filled, s, p.second, oarg1, oarg2, oarg3, oargs, okwargs,
+                                 func_name_cb);
+                } else {
+                    assert(!rewrite_args && "would need to make sure that this didn't need to go into r_kwargs");
+                    assert(okwargs);
+
+                    Box*& v = okwargs->d[p.first];
+                    okwargs->keysChanged();
+                    if (v) {
+                        raiseExcHelper(TypeError, "%s() got multiple values for keyword argument '%s'", func_name_cb(),
+                                       s->data());
+                    }
+                    v = incref(p.second);
+                    incref(p.first);
+                    assert(!rewrite_args);
                 }
-                v = incref(p.second);
-                incref(p.first);
-                assert(!rewrite_args);
             }
         }
     }
@@ -5783,6 +6012,55 @@ Box* compareInternal(Box* lhs, Box* rhs, int op_type, CompareRewriteArgs* rewrit
     if (op_type == AST_TYPE::In || op_type == AST_TYPE::NotIn) {
         static BoxedString* contains_str = getStaticString("__contains__");
 
+        // Kernels for the common combinations of builtin container and element type; the IC guards on both classes.
+        objobjproc contains_func = NULL;
+        if (lhs->cls == int_cls) {
+            if (rhs->cls == list_cls)
+                contains_func = (objobjproc)listContainsIntCapi;
+            else if (rhs->cls == tuple_cls)
+                contains_func = (objobjproc)tupleContainsIntCapi;
+            else if (rhs->cls == set_cls || rhs->cls == frozenset_cls)
+                contains_func = (objobjproc)setContainsHashableCapi;
+        } else if (lhs->cls == str_cls) {
+            if (rhs->cls == list_cls)
+                contains_func = (objobjproc)listContainsStrCapi;
+            else if (rhs->cls == tuple_cls)
+                contains_func = (objobjproc)tupleContainsStrCapi;
+            else if (rhs->cls == set_cls || rhs->cls == frozenset_cls)
+                contains_func = (objobjproc)setContainsHashableCapi;
+            else if (rhs->cls == dict_cls)
+                contains_func = (objobjproc)dictContainsStrCapi;
+            else if (rhs->cls == str_cls)
+                contains_func = (objobjproc)strContainsStrCapi;
+        }
+
+        if (contains_func) {
+            if (rewrite_args) {
+                RewriterVar* r_lhs = rewrite_args->lhs;
+                RewriterVar* r_rhs = rewrite_args->rhs;
+                r_lhs->addAttrGuard(offsetof(Box, cls), (intptr_t)lhs->cls);
+                r_rhs->addAttrGuard(offsetof(Box, cls), (intptr_t)rhs->cls);
+                RewriterVar* r_b = rewrite_args->rewriter->call(true, (void*)contains_func, r_rhs, r_lhs);
+                rewrite_args->rewriter->checkAndThrowCAPIException(r_b, -1, assembler::MovType::L);
+
+                RewriterVar* r_r;
+                if (op_type == AST_TYPE::NotIn)
+                    r_r = rewrite_args->rewriter->call(false, (void*)boxBoolNegated, r_b)->setType(RefType::OWNED);
+                else
+                    r_r = rewrite_args->rewriter->call(false, (void*)boxBool, r_b)->setType(RefType::OWNED);
+
+                rewrite_args->out_success = true;
+                rewrite_args->out_rtn = r_r;
+            }
+
+            int r = contains_func(rhs, lhs);
+            if (r == -1)
+                throwCAPIException();
+            if (op_type == AST_TYPE::NotIn)
+                r = !r;
+            return boxBool(r);
+        }
+
         // The checks for this branch are taken from CPython's PySequence_Contains
         if (PyType_HasFeature(rhs->cls, Py_TPFLAGS_HAVE_SEQUENCE_IN)) {
             PySequenceMethods* sqm = rhs->cls->tp_as_sequence;
@@ -6420,6 +6698,49 @@ Box* getitemInternal(Box* target, Box* slice, GetitemRewriteArgs* rewrite_args)
     // For now, just use the first clause: call mp_subscript if it exists.
     // And only if we think it's better than calling __getitem__, which should
     // exist if mp_subscript exists.
+
+    // list[int] is common enough that we skip mp_subscript's index dispatch and pass the unboxed index
+    // straight to the list code.
+    if (target->cls == list_cls && slice->cls == int_cls) {
+        if (rewrite_args) {
+            RewriterVar* r_obj = rewrite_args->target;
+            RewriterVar* r_slice = rewrite_args->slice;
+            r_obj->addAttrGuard(offsetof(Box, cls), (intptr_t)list_cls);
+            r_slice->addAttrGuard(offsetof(Box, cls), (intptr_t)int_cls);
+            RewriterVar* r_n = r_slice->getAttr(offsetof(BoxedInt, n));
+            RewriterVar* r_rtn = rewrite_args->rewriter->call(true, (void*)listGetitemUnboxedCapi, r_obj, r_n)
+                                     ->setType(RefType::OWNED);
+            if (S == CXX)
+                rewrite_args->rewriter->checkAndThrowCAPIException(r_rtn);
+            rewrite_args->out_success = true;
+            rewrite_args->out_rtn = r_rtn;
+        }
+        Box* r = listGetitemUnboxedCapi(static_cast<BoxedList*>(target), static_cast<BoxedInt*>(slice)->n);
+        if (S == CXX && !r)
+            throwCAPIException();
+        return r;
+    }
+
+    // Similarly for dict[str], which also lets the dict code cache where the key was found.
+    if (target->cls == dict_cls && slice->cls == str_cls) {
+        if (rewrite_args) {
+            RewriterVar* r_obj = rewrite_args->target;
+            RewriterVar* r_slice = rewrite_args->slice;
+            r_obj->addAttrGuard(offsetof(Box, cls), (intptr_t)dict_cls);
+            r_slice->addAttrGuard(offsetof(Box, cls), (intptr_t)str_cls);
+            RewriterVar* r_rtn = rewrite_args->rewriter->call(true, (void*)dictGetitemStrCapi, r_obj, r_slice)
+                                     ->setType(RefType::OWNED);
+            if (S == CXX)
+                rewrite_args->rewriter->checkAndThrowCAPIException(r_rtn);
+            rewrite_args->out_success = true;
+            rewrite_args->out_rtn = r_rtn;
+        }
+        Box* r = dictGetitemStrCapi(static_cast<BoxedDict*>(target), static_cast<BoxedString*>(slice));
+        if (S == CXX && !r)
+            throwCAPIException();
+        return r;
+    }
+
     PyMappingMethods* m = target->cls->tp_as_mapping;
     if (m && m->mp_subscript && m->mp_subscript != slot_mp_subscript) {
         if (rewrite_args) {
@@ -6560,6 +6881,44 @@ extern "C" void setitem(Box* target, Box* slice, Box* value) {
 
     static BoxedString* setitem_str = getStaticString("__setitem__");
 
+    // See the corresponding case in getitemInternal.
+    if (target->cls == list_cls && slice->cls == int_cls) {
+        if (rewriter.get()) {
+            RewriterVar* r_obj = rewriter->getArg(0);
+            RewriterVar* r_slice = rewriter->getArg(1);
+            RewriterVar* r_value = rewriter->getArg(2);
+            r_obj->addAttrGuard(offsetof(Box, cls), (intptr_t)list_cls);
+            r_slice->addAttrGuard(offsetof(Box, cls), (intptr_t)int_cls);
+            RewriterVar* r_n = r_slice->getAttr(offsetof(BoxedInt, n));
+            RewriterVar* r_ret = rewriter->call(true, (void*)listSetitemUnboxedCapi, r_obj, r_n, r_value);
+            rewriter->checkAndThrowCAPIException(r_ret, -1, assembler::MovType::L);
+            rewriter->commit();
+        }
+
+        int ret = listSetitemUnboxedCapi(static_cast<BoxedList*>(target), static_cast<BoxedInt*>(slice)->n, value);
+        if (ret == -1)
+            throwCAPIException();
+        return;
+    }
+
+    if (target->cls == dict_cls && slice->cls == str_cls) {
+        if (rewriter.get()) {
+            RewriterVar* r_obj = rewriter->getArg(0);
+            RewriterVar* r_slice = rewriter->getArg(1);
+            RewriterVar* r_value = rewriter->getArg(2);
+            r_obj->addAttrGuard(offsetof(Box, cls), (intptr_t)dict_cls);
+            r_slice->addAttrGuard(offsetof(Box, cls), (intptr_t)str_cls);
+            RewriterVar* r_ret = rewriter->call(true, (void*)dictSetitemStrCapi, r_obj, r_slice, r_value);
+            rewriter->checkAndThrowCAPIException(r_ret, -1, assembler::MovType::L);
+            rewriter->commit();
+        }
+
+        int ret = dictSetitemStrCapi(static_cast<BoxedDict*>(target), static_cast<BoxedString*>(slice), value);
+        if (ret == -1)
+            throwCAPIException();
+        return;
+    }
+
     auto&& m = target->cls->tp_as_mapping;
     if (m && m->mp_ass_subscript && m->mp_ass_subscript != slot_mp_ass_subscript) {
         if (rewriter.get()) {
@@ -6695,6 +7054,7 @@ void Box::delattr(BoxedString* attr, DelattrRewriteArgs* rewrite_args) {
         Box* key = it->first.value;
         Box* value = it->second;
         d->d.erase(it);
+        d->keysChanged();
         Py_DECREF(key);
         Py_DECREF(value);
         return;
@@ -6927,6 +7287,10 @@ void assertValidSlotIdentifier(Box* s) {
 }
 
 Box* _typeNew(BoxedClass* metatype, BoxedString* name, BoxedTuple* bases, BoxedDict* attr_dict) {
+    STAT_TIMER(t0, "us_timer_class_creation", 10);
+    static StatCounter num_classes_created("num_classes_created");
+    num_classes_created.log();
+
     if (bases->size() == 0) {
         bases = BoxedTuple::create({ object_cls });
     } else {
@@ -7355,6 +7719,16 @@ extern "C" Box* getGlobal(Box* globals, BoxedString* name) {
                 r_mod->addAttrGuard(offsetof(Box, cls), (intptr_t)module_cls);
 
                 GetattrRewriteArgs rewrite_args(rewriter.get(), r_mod, rewriter->getReturnDestination());
+
+                // Only depend on where this particular global is stored (or on it not existing), so that defining
+                // other globals doesn't throw away the IC.
+                HiddenClass* hcls = m->getHCAttrsPtr()->hcls;
+                if (hcls && hcls->type == HiddenClass::SINGLETON) {
+                    r_mod->addAttrGuard(module_cls->attrs_offset + offsetof(HCAttrs, hcls), (intptr_t)hcls);
+                    hcls->getAsSingleton()->addDependence(rewriter.get(), name);
+                    rewrite_args.obj_hcls_guarded = true;
+                }
+
                 r = m->getattr(name, &rewrite_args);
                 if (!rewrite_args.isSuccessful()) {
                     rewriter.reset(NULL);
@@ -7385,11 +7759,25 @@ extern "C" Box* getGlobal(Box* globals, BoxedString* name) {
             ASSERT(globals->cls == dict_cls, "%s", globals->cls->tp_name);
             BoxedDict* d = static_cast<BoxedDict*>(globals);
 
-            rewriter.reset(NULL);
-            REWRITE_ABORTED("Rewriting not implemented for getGlobals with a dict globals yet");
-
             auto it = d->d.find(name);
+
+            // While the dict's keys_version stays the same, the global stays in the same bucket (or stays missing),
+            // so the IC is a version check followed by a single load.  Assigning to existing globals doesn't change
+            // the version.
+            if (rewriter.get()) {
+                RewriterVar* r_globals = rewriter->getArg(0);
+                r_globals->addGuard((intptr_t)d);
+                r_globals->addAttrGuard(offsetof(BoxedDict, keys_version), d->keys_version);
+            }
+
             if (it != d->d.end()) {
+                if (rewriter.get()) {
+                    RewriterVar* r_rtn = rewriter->loadConst((intptr_t)&it->second)
+                                             ->getAttr(0, rewriter->getReturnDestination())
+                                             ->setType(RefType::BORROWED);
+                    rewriter->commitReturning(r_rtn);
+                }
+
                 assert(it->second->ob_refcnt > 0);
                 Py_INCREF(it->second);
                 return it->second;
@@ -7404,6 +7792,14 @@ extern "C" Box* getGlobal(Box* globals, BoxedString* name) {
             RewriterVar* builtins = rewriter->loadConst((intptr_t)builtins_module, Location::any());
             GetattrRewriteArgs rewrite_args(rewriter.get(), builtins, rewriter->getReturnDestination());
             rewrite_args.obj_shape_guarded = true; // always builtin module
+
+            HiddenClass* hcls = builtins_module->getHCAttrsPtr()->hcls;
+            if (hcls && hcls->type == HiddenClass::SINGLETON) {
+                builtins->addAttrGuard(module_cls->attrs_offset + offsetof(HCAttrs, hcls), (intptr_t)hcls);
+                hcls->getAsSingleton()->addDependence(rewriter.get(), name);
+                rewrite_args.obj_hcls_guarded = true;
+            }
+
             rtn = builtins_module->getattr(name, &rewrite_args);
 
             if (!rewrite_args.isSuccessful())
@@ -7589,6 +7985,7 @@ extern "C" void boxedLocalsDel(Box* boxedLocals, BoxedString* attr) {
     Box* key = it->first.value;
     Box* value = it->second;
     d.erase(it);
+    static_cast<BoxedDict*>(boxedLocals)->keysChanged();
     Py_DECREF(key);
     Py_DECREF(value);
 }
@@ -763,6 +763,17 @@ Box* setContains(BoxedSet* self, Box* key) {
     return boxBool(self->s.find(key) != self->s.end());
 }
 
+// setContains for keys that are known to be hashable (the compare IC uses this for exact ints and strs).
+extern "C" int setContainsHashableCapi(BoxedSet* self, Box* key) noexcept {
+    assert(PyAnySet_Check(self));
+    try {
+        return self->s.find(key) != self->s.end();
+    } catch (ExcInfo e) {
+        setCAPIException(e);
+        return -1;
+    }
+}
+
 Box* setRemove(BoxedSet* self, Box* key) {
     RELEASE_ASSERT(isSubclass(self->cls, set_cls), "");
 
@@ -43,6 +43,7 @@ public:
 };
 
 void _setAddStolen(BoxedSet* self, STOLEN(Box*) val);
+extern "C" int setContainsHashableCapi(BoxedSet* self, Box* key) noexcept;
 }
 
 #endif
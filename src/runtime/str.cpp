@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
 #include <sstream>
 #include <unordered_map>
 
@@ -36,12 +37,12 @@
 
 extern "C" PyObject* string_count(PyStringObject* self, PyObject* args) noexcept;
 extern "C" PyObject* string_join(PyStringObject* self, PyObject* orig) noexcept;
-extern "C" PyObject* string_split(PyStringObject* self, PyObject* args) noexcept;
-extern "C" PyObject* string_rsplit(PyStringObject* self, PyObject* args) noexcept;
-extern "C" PyObject* string_find(PyStringObject* self, PyObject* args) noexcept;
-extern "C" PyObject* string_index(PyStringObject* self, PyObject* args) noexcept;
-extern "C" PyObject* string_rindex(PyStringObject* self, PyObject* args) noexcept;
-extern "C" PyObject* string_rfind(PyStringObject* self, PyObject* args) noexcept;
+extern "C" PyObject* string_split(PyStringObject* self, PyObject** args, Py_ssize_t nargs) noexcept;
+extern "C" PyObject* string_rsplit(PyStringObject* self, PyObject** args, Py_ssize_t nargs) noexcept;
+extern "C" PyObject* string_find(PyStringObject* self, PyObject** args, Py_ssize_t nargs) noexcept;
+extern "C" PyObject* string_index(PyStringObject* self, PyObject** args, Py_ssize_t nargs) noexcept;
+extern "C" PyObject* string_rindex(PyStringObject* self, PyObject** args, Py_ssize_t nargs) noexcept;
+extern "C" PyObject* string_rfind(PyStringObject* self, PyObject** args, Py_ssize_t nargs) noexcept;
 extern "C" PyObject* string_partition(PyStringObject* self, PyObject* sep_obj) noexcept;
 extern "C" PyObject* string_rpartition(PyStringObject* self, PyObject* sep_obj) noexcept;
 extern "C" PyObject* string_repeat(PyStringObject* a, Py_ssize_t n) noexcept;
@@ -621,20 +622,672 @@ Py_LOCAL_INLINE(int) formatchar(char* buf, size_t buflen, PyObject* v) {
 }
 
 #define FORMATBUFLEN (size_t)120
+
+// Pyston change: the code that formats a single directive has been split out of PyString_Format, so that it can
+// be shared with the compiled format strings below.
+//
+// Formats v, the argument of a directive (unused for "%%"), into the result being built.  result, res, reslen
+// and rescnt are PyString_Format's output state, fmtcnt the number of format characters left (which is used to
+// decide how much to grow the result by) and fmt_index the index of the conversion character, for error messages.
+// Returns 1 on success and -1 on error, after which *presult might have been freed and set to NULL.  Returns 0,
+// without having written anything, if v has to be formatted as unicode.
+static int formatStrDirective(PyObject** presult, char** pres, Py_ssize_t* preslen, Py_ssize_t* prescnt,
+                              Py_ssize_t fmtcnt, int flags, Py_ssize_t width, int prec, int c, PyObject* v,
+                              Py_ssize_t fmt_index) {
+    PyObject* result = *presult;
+    char* res = *pres;
+    Py_ssize_t reslen = *preslen;
+    Py_ssize_t rescnt = *prescnt;
+    int fill;
+    int isnumok;
+    PyObject* temp = NULL;
+    const char* pbuf;
+    int sign;
+    Py_ssize_t len;
+    char formatbuf[FORMATBUFLEN];
+
+    sign = 0;
+    fill = ' ';
+    switch (c) {
+        case '%':
+            pbuf = "%";
+            len = 1;
+            break;
+        case 's':
+#ifdef Py_USING_UNICODE
+            if (PyUnicode_Check(v))
+                return 0;
+#endif
+            temp = _PyObject_Str(v);
+#ifdef Py_USING_UNICODE
+            if (temp != NULL && PyUnicode_Check(temp)) {
+                Py_DECREF(temp);
+                return 0;
+            }
+#endif
+        /* Fall through */
+        case 'r':
+            if (c == 'r')
+                temp = PyObject_Repr(v);
+            if (temp == NULL)
+                return -1;
+            if (!PyString_Check(temp)) {
+                PyErr_SetString(PyExc_TypeError, "%s argument has non-string str()");
+                Py_DECREF(temp);
+                return -1;
+            }
+            pbuf = PyString_AS_STRING(temp);
+            len = PyString_GET_SIZE(temp);
+            if (prec >= 0 && len > prec)
+                len = prec;
+            break;
+        case 'i':
+        case 'd':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            if (c == 'i')
+                c = 'd';
+            isnumok = 0;
+            if (PyNumber_Check(v)) {
+                PyObject* iobj = NULL;
+
+                if (PyInt_Check(v) || (PyLong_Check(v))) {
+                    iobj = v;
+                    Py_INCREF(iobj);
+                } else {
+                    iobj = PyNumber_Int(v);
+                    if (iobj == NULL) {
+                        PyErr_Clear();
+                        iobj = PyNumber_Long(v);
+                    }
+                }
+                if (iobj != NULL) {
+                    if (PyInt_Check(iobj)) {
+                        isnumok = 1;
+                        pbuf = formatbuf;
+                        // Pyston change:
+                        len = formatint(formatbuf /* pbuf */, sizeof(formatbuf), flags, prec, c, iobj);
+                        Py_DECREF(iobj);
+                        if (len < 0)
+                            return -1;
+                        sign = 1;
+                    } else if (PyLong_Check(iobj)) {
+                        int ilen;
+
+                        isnumok = 1;
+                        temp = _PyString_FormatLong(iobj, flags, prec, c, &pbuf, &ilen);
+                        Py_DECREF(iobj);
+                        len = ilen;
+                        if (!temp)
+                            return -1;
+                        sign = 1;
+                    } else {
+                        Py_DECREF(iobj);
+                    }
+                }
+            }
+            if (!isnumok) {
+                PyErr_Format(PyExc_TypeError, "%%%c format: a number is required, "
+                                              "not %.200s",
+                             c, Py_TYPE(v)->tp_name);
+                return -1;
+            }
+            if (flags & F_ZERO)
+                fill = '0';
+            break;
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+            temp = formatfloat(v, flags, prec, c);
+            if (temp == NULL)
+                return -1;
+            pbuf = PyString_AS_STRING(temp);
+            len = PyString_GET_SIZE(temp);
+            sign = 1;
+            if (flags & F_ZERO)
+                fill = '0';
+            break;
+        case 'c':
+#ifdef Py_USING_UNICODE
+            if (PyUnicode_Check(v))
+                return 0;
+#endif
+            pbuf = formatbuf;
+            // Pyston change:
+            len = formatchar(formatbuf /* was pbuf */, sizeof(formatbuf), v);
+            if (len < 0)
+                return -1;
+            break;
+        default:
+            PyErr_Format(PyExc_ValueError, "unsupported format character '%c' (0x%x) "
+                                           "at index %zd",
+                         c, c, fmt_index);
+            return -1;
+    }
+    if (sign) {
+        if (*pbuf == '-' || *pbuf == '+') {
+            sign = *pbuf++;
+            len--;
+        } else if (flags & F_SIGN)
+            sign = '+';
+        else if (flags & F_BLANK)
+            sign = ' ';
+        else
+            sign = 0;
+    }
+    if (width < len)
+        width = len;
+    if (rescnt - (sign != 0) < width) {
+        reslen -= rescnt;
+        rescnt = width + fmtcnt + 100;
+        reslen += rescnt;
+        if (reslen < 0) {
+            Py_DECREF(result);
+            *presult = NULL;
+            Py_XDECREF(temp);
+            PyErr_NoMemory();
+            return -1;
+        }
+        if (_PyString_Resize(&result, reslen)) {
+            *presult = NULL;
+            Py_XDECREF(temp);
+            return -1;
+        }
+        res = PyString_AS_STRING(result) + reslen - rescnt;
+    }
+    if (sign) {
+        if (fill != ' ')
+            *res++ = sign;
+        rescnt--;
+        if (width > len)
+            width--;
+    }
+    if ((flags & F_ALT) && (c == 'x' || c == 'X')) {
+        assert(pbuf[0] == '0');
+        assert(pbuf[1] == c);
+        if (fill != ' ') {
+            *res++ = *pbuf++;
+            *res++ = *pbuf++;
+        }
+        rescnt -= 2;
+        width -= 2;
+        if (width < 0)
+            width = 0;
+        len -= 2;
+    }
+    if (width > len && !(flags & F_LJUST)) {
+        do {
+            --rescnt;
+            *res++ = fill;
+        } while (--width > len);
+    }
+    if (fill == ' ') {
+        if (sign)
+            *res++ = sign;
+        if ((flags & F_ALT) && (c == 'x' || c == 'X')) {
+            assert(pbuf[0] == '0');
+            assert(pbuf[1] == c);
+            *res++ = *pbuf++;
+            *res++ = *pbuf++;
+        }
+    }
+    Py_MEMCPY(res, pbuf, len);
+    res += len;
+    rescnt -= len;
+    while (--width >= len) {
+        --rescnt;
+        *res++ = ' ';
+    }
+    Py_XDECREF(temp);
+
+    *presult = result;
+    *pres = res;
+    *preslen = reslen;
+    *prescnt = rescnt;
+    return 1;
+}
+
+#ifdef Py_USING_UNICODE
+// Pyston change: split out of PyString_Format.
+//
+// Called once an argument turned out to be unicode: formats the rest of the format string, starting at fmt, with
+// the remaining arguments, starting at argidx, as unicode and returns the concatenation of what was already
+// written to result (up to res) and of that.  Steals the reference to result.
+static PyObject* formatStrRestAsUnicode(PyObject* result, char* res, PyObject* format, const char* fmt,
+                                        PyObject* orig_args, Py_ssize_t argidx) {
+    PyObject* args, *v, *w;
+    Py_ssize_t fmtcnt;
+
+    /* Fiddle args right (remove the first argidx arguments) */
+    if (PyTuple_Check(orig_args) && argidx > 0) {
+        Py_ssize_t n = PyTuple_GET_SIZE(orig_args) - argidx;
+        args = PyTuple_New(n);
+        if (args == NULL) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        while (--n >= 0) {
+            w = PyTuple_GET_ITEM(orig_args, n + argidx);
+            Py_INCREF(w);
+            PyTuple_SET_ITEM(args, n, w);
+        }
+    } else {
+        Py_INCREF(orig_args);
+        args = orig_args;
+    }
+    /* Take what we have of the result and let the Unicode formatting
+       function format the rest of the input. */
+    if (_PyString_Resize(&result, res - PyString_AS_STRING(result))) {
+        Py_DECREF(args);
+        return NULL;
+    }
+    fmtcnt = PyString_GET_SIZE(format) - (fmt - PyString_AS_STRING(format));
+    format = PyUnicode_Decode(fmt, fmtcnt, NULL, NULL);
+    if (format == NULL)
+        goto error;
+    v = PyUnicode_Format(format, args);
+    Py_DECREF(format);
+    if (v == NULL)
+        goto error;
+    /* Paste what we have (result) to what the Unicode formatting
+       function returned (v) and return the result (or error) */
+    w = PyUnicode_Concat(result, v);
+    Py_DECREF(result);
+    Py_DECREF(v);
+    Py_DECREF(args);
+    return w;
+
+error:
+    Py_DECREF(result);
+    Py_DECREF(args);
+    return NULL;
+}
+#endif /* Py_USING_UNICODE */
+
+// Pyston addition: format strings that get used with str % over and over -- typically constants, which are
+// interned -- are parsed once into a list of directives, so that PyString_Format only has to copy their literal
+// parts and format the arguments.  This also lets it presize the result from the length of the literal parts.
+//
+// Format strings that use '*' (whose parsing depends on the arguments) or that have errors in them aren't
+// compiled; they go through the generic loop, which reports errors in the right order relative to the
+// conversions of the arguments.
+namespace {
+struct CompiledStrFormat {
+    struct Directive {
+        Py_ssize_t literal_start, literal_len; // the literal text preceding the directive
+        Py_ssize_t fmt_start;                  // index of the '%'
+        Py_ssize_t fmt_end;                    // index just past the conversion character
+        PyObject* key;                         // the key of a %(key)x directive, or NULL
+        int flags;
+        Py_ssize_t width;
+        int prec;
+        int c;
+    };
+
+    llvm::SmallVector<Directive, 4> directives;
+    Py_ssize_t tail_start;  // the literal text after the last directive starts here
+    Py_ssize_t literal_len; // total length of the literal text
+    int in_use;             // how many calls are formatting with this right now
+
+    ~CompiledStrFormat() {
+        for (auto& d : directives)
+            Py_XDECREF(d.key);
+    }
+};
+}
+
+// A small 2-way set-associative cache from interned format strings (which it holds a reference to) to their
+// compiled version.  Entries count their hits, up to a small limit; a format string that maps to a full set wears
+// down the count of the less used entry on every miss and only replaces it once that reaches zero, so formats that
+// are used over and over stay compiled and the ones that aren't don't pin any memory for long.  Format strings
+// only get compiled once they're found in the cache, so that cycling through more of them than fit doesn't cost a
+// compile on every miss.  Entries that are being formatted with (which can run arbitrary code, that might format
+// other strings) never get replaced.
+//
+// Compiling doesn't pay off for formats without %(key) directives and with little literal text, which the generic
+// loop handles just as fast.  Format strings that are too short to have enough literal text don't even get looked
+// up; the others that aren't worth it, or that can't be compiled, are cached with a NULL compiled version so that
+// they don't get parsed twice.
+struct StrFormatCacheEntry {
+    PyObject* format;
+    CompiledStrFormat* compiled;
+    int hits;
+    bool parsed; // whether compiled is known yet
+};
+static const int STR_FORMAT_CACHE_SETS = 128;
+static const int STR_FORMAT_CACHE_WAYS = 2;
+static const int STR_FORMAT_CACHE_MAX_HITS = 3;
+static const Py_ssize_t MIN_COMPILED_LITERAL_LEN = 16;
+static StrFormatCacheEntry str_format_cache[STR_FORMAT_CACHE_SETS][STR_FORMAT_CACHE_WAYS];
+
+static CompiledStrFormat* compileStrFormat(PyObject* format) noexcept {
+    const char* start = PyString_AS_STRING(format);
+    const char* end = start + PyString_GET_SIZE(format);
+    const char* fmt = start;
+    const char* literal = start;
+    int c;
+
+    std::unique_ptr<CompiledStrFormat> compiled(new CompiledStrFormat());
+    compiled->literal_len = 0;
+    compiled->in_use = 0;
+
+// Reads the next character into c, giving up if we ran out of them (which is an "incomplete format" error).
+#define NEXT_CHAR()                                                                                                    \
+    do {                                                                                                               \
+        if (fmt == end)                                                                                                \
+            return NULL;                                                                                               \
+        c = Py_CHARMASK(*fmt++);                                                                                       \
+    } while (0)
+
+    while ((fmt = (const char*)memchr(fmt, '%', end - fmt)) != NULL) {
+        CompiledStrFormat::Directive d;
+        d.literal_start = literal - start;
+        d.literal_len = fmt - literal;
+        d.fmt_start = fmt - start;
+        d.key = NULL;
+        d.flags = 0;
+        d.width = -1;
+        d.prec = -1;
+
+        const char* keystart = NULL;
+        Py_ssize_t keylen = 0;
+
+        fmt++;
+        NEXT_CHAR();
+        if (c == '(') {
+            int pcount = 1;
+            keystart = fmt;
+            while (pcount > 0) {
+                NEXT_CHAR();
+                if (c == ')')
+                    --pcount;
+                else if (c == '(')
+                    ++pcount;
+            }
+            keylen = fmt - keystart - 1;
+            NEXT_CHAR();
+        }
+        while (true) {
+            if (c == '-')
+                d.flags |= F_LJUST;
+            else if (c == '+')
+                d.flags |= F_SIGN;
+            else if (c == ' ')
+                d.flags |= F_BLANK;
+            else if (c == '#')
+                d.flags |= F_ALT;
+            else if (c == '0')
+                d.flags |= F_ZERO;
+            else
+                break;
+            NEXT_CHAR();
+        }
+        if (c == '*')
+            return NULL;
+        if (isdigit(c)) {
+            d.width = c - '0';
+            while (true) {
+                NEXT_CHAR();
+                if (!isdigit(c))
+                    break;
+                if (d.width > (PY_SSIZE_T_MAX - (c - '0')) / 10)
+                    return NULL;
+                d.width = d.width * 10 + (c - '0');
+            }
+        }
+        if (c == '.') {
+            d.prec = 0;
+            NEXT_CHAR();
+            if (c == '*')
+                return NULL;
+            if (isdigit(c)) {
+                d.prec = c - '0';
+                while (true) {
+                    NEXT_CHAR();
+                    if (!isdigit(c))
+                        break;
+                    if (d.prec > (INT_MAX - (c - '0')) / 10)
+                        return NULL;
+                    d.prec = d.prec * 10 + (c - '0');
+                }
+            }
+        }
+        if (c == 'h' || c == 'l' || c == 'L')
+            NEXT_CHAR();
+        if (c == '\0' || !strchr("%srdiuoxXeEfFgGc", c))
+            return NULL;
+        d.c = c;
+        d.fmt_end = fmt - start;
+
+        if (keystart) {
+            d.key = PyString_FromStringAndSize(keystart, keylen);
+            if (!d.key) {
+                PyErr_Clear();
+                return NULL;
+            }
+            // Interning the key makes looking it up in the mapping cheaper.
+            PyString_InternInPlace(&d.key);
+        }
+        compiled->directives.push_back(d);
+        compiled->literal_len += d.literal_len;
+        literal = fmt;
+    }
+#undef NEXT_CHAR
+
+    compiled->tail_start = literal - start;
+    compiled->literal_len += end - literal;
+    return compiled.release();
+}
+
+static bool isWorthCompiling(CompiledStrFormat* compiled) {
+    if (compiled->literal_len >= MIN_COMPILED_LITERAL_LEN)
+        return true;
+    for (auto& d : compiled->directives) {
+        if (d.key)
+            return true;
+    }
+    return false;
+}
+
+static CompiledStrFormat* getCompiledStrFormat(PyObject* format) noexcept {
+    StrFormatCacheEntry* set = str_format_cache[((uintptr_t)format >> 4) & (STR_FORMAT_CACHE_SETS - 1)];
+    for (int i = 0; i < STR_FORMAT_CACHE_WAYS; i++) {
+        if (set[i].format == format) {
+            if (set[i].hits < STR_FORMAT_CACHE_MAX_HITS)
+                set[i].hits++;
+            if (!set[i].parsed) {
+                set[i].compiled = compileStrFormat(format);
+                if (set[i].compiled && !isWorthCompiling(set[i].compiled)) {
+                    delete set[i].compiled;
+                    set[i].compiled = NULL;
+                }
+                set[i].parsed = true;
+            }
+            return set[i].compiled;
+        }
+    }
+
+    StrFormatCacheEntry* victim = NULL;
+    for (int i = 0; i < STR_FORMAT_CACHE_WAYS; i++) {
+        if (!set[i].format) {
+            victim = &set[i];
+            break;
+        }
+        if (set[i].compiled && set[i].compiled->in_use)
+            continue;
+        if (!victim || set[i].hits < victim->hits)
+            victim = &set[i];
+    }
+    if (!victim)
+        return NULL;
+    if (victim->hits > 0) {
+        victim->hits--;
+        return NULL;
+    }
+
+    delete victim->compiled;
+    Py_XDECREF(victim->format);
+    Py_INCREF(format);
+    victim->format = format;
+    victim->compiled = NULL;
+    victim->hits = 0;
+    victim->parsed = false;
+    return NULL;
+}
+
+void clearStrFormatCache() {
+    for (auto& set : str_format_cache) {
+        for (auto& entry : set) {
+            delete entry.compiled;
+            Py_XDECREF(entry.format);
+            entry = StrFormatCacheEntry();
+        }
+    }
+}
+
+// The same as the generic loop in PyString_Format, except that it takes the directives from a compiled format.
+static PyObject* formatStrCompiled(CompiledStrFormat* compiled, PyObject* format, PyObject* args) noexcept {
+    const char* fmt = PyString_AS_STRING(format);
+    Py_ssize_t fmtlen = PyString_GET_SIZE(format);
+    char* res;
+    Py_ssize_t arglen, argidx;
+    Py_ssize_t reslen, rescnt;
+    int args_owned = 0;
+    PyObject* result, *orig_args;
+    PyObject* dict = NULL;
+
+    orig_args = args;
+    // Leave some room for the formatted arguments on top of the literal text.
+    reslen = rescnt = compiled->literal_len + 32 * compiled->directives.size() + 8;
+    result = PyString_FromStringAndSize((char*)NULL, reslen);
+    if (result == NULL)
+        return NULL;
+    res = PyString_AS_STRING(result);
+    if (PyTuple_Check(args)) {
+        arglen = PyTuple_GET_SIZE(args);
+        argidx = 0;
+    } else {
+        arglen = -1;
+        argidx = -2;
+    }
+    if (Py_TYPE(args)->tp_as_mapping && Py_TYPE(args)->tp_as_mapping->mp_subscript && !PyTuple_Check(args)
+        && !PyObject_TypeCheck(args, &PyBaseString_Type))
+        dict = args;
+
+    for (auto& d : compiled->directives) {
+        PyObject* v = NULL;
+        Py_ssize_t argidx_start = argidx;
+        int r;
+
+        if (rescnt < d.literal_len) {
+            reslen -= rescnt;
+            rescnt = d.literal_len + (fmtlen - d.fmt_start) + 100;
+            reslen += rescnt;
+            if (_PyString_Resize(&result, reslen))
+                goto error;
+            res = PyString_AS_STRING(result) + reslen - rescnt;
+        }
+        Py_MEMCPY(res, fmt + d.literal_start, d.literal_len);
+        res += d.literal_len;
+        rescnt -= d.literal_len;
+
+        if (d.key) {
+            if (dict == NULL) {
+                PyErr_SetString(PyExc_TypeError, "format requires a mapping");
+                goto error;
+            }
+            if (args_owned) {
+                Py_DECREF(args);
+                args_owned = 0;
+            }
+            args = PyObject_GetItem(dict, d.key);
+            if (args == NULL)
+                goto error;
+            args_owned = 1;
+            arglen = -1;
+            argidx = -2;
+        }
+        if (d.c != '%') {
+            v = getnextarg(args, arglen, &argidx);
+            if (v == NULL)
+                goto error;
+        }
+        r = formatStrDirective(&result, &res, &reslen, &rescnt, fmtlen - d.fmt_end, d.flags, d.width, d.prec, d.c,
+                               v, d.fmt_end - 1);
+        if (r < 0)
+            goto error;
+#ifdef Py_USING_UNICODE
+        if (r == 0) {
+            if (args_owned)
+                Py_DECREF(args);
+            return formatStrRestAsUnicode(result, res, format, fmt + d.fmt_start, orig_args, argidx_start);
+        }
+#endif
+        if (dict && (argidx < arglen) && d.c != '%') {
+            PyErr_SetString(PyExc_TypeError, "not all arguments converted during string formatting");
+            goto error;
+        }
+    }
+
+    {
+        Py_ssize_t tail_len = fmtlen - compiled->tail_start;
+        if (rescnt < tail_len) {
+            reslen += tail_len - rescnt;
+            rescnt = tail_len;
+            if (_PyString_Resize(&result, reslen))
+                goto error;
+            res = PyString_AS_STRING(result) + reslen - rescnt;
+        }
+        Py_MEMCPY(res, fmt + compiled->tail_start, tail_len);
+        rescnt -= tail_len;
+    }
+
+    if (argidx < arglen && !dict) {
+        PyErr_SetString(PyExc_TypeError, "not all arguments converted during string formatting");
+        goto error;
+    }
+    if (args_owned) {
+        Py_DECREF(args);
+    }
+    if (_PyString_Resize(&result, reslen - rescnt))
+        return NULL;
+    return result;
+
+error:
+    Py_XDECREF(result);
+    if (args_owned) {
+        Py_DECREF(args);
+    }
+    return NULL;
+}
+
 extern "C" PyObject* PyString_Format(PyObject* format, PyObject* args) noexcept {
     char* fmt, *res;
     Py_ssize_t arglen, argidx;
     Py_ssize_t reslen, rescnt, fmtcnt;
     int args_owned = 0;
     PyObject* result, *orig_args;
-#ifdef Py_USING_UNICODE
-    PyObject* v, *w;
-#endif
     PyObject* dict = NULL;
     if (format == NULL || !PyString_Check(format) || args == NULL) {
         PyErr_BadInternalCall();
         return NULL;
     }
+    // Pyston change: use the compiled version of interned format strings.
+    if (PyString_CHECK_INTERNED(format) && PyString_CheckExact(format)
+        && PyString_GET_SIZE(format) >= MIN_COMPILED_LITERAL_LEN) {
+        CompiledStrFormat* compiled = getCompiledStrFormat(format);
+        if (compiled) {
+            compiled->in_use++;
+            PyObject* r = formatStrCompiled(compiled, format, args);
+            compiled->in_use--;
+            return r;
+        }
+    }
     orig_args = args;
     fmt = PyString_AS_STRING(format);
     fmtcnt = PyString_GET_SIZE(format);
@@ -670,15 +1323,8 @@ extern "C" PyObject* PyString_Format(PyObject* format, PyObject* args) noexcept
             Py_ssize_t width = -1;
             int prec = -1;
             int c = '\0';
-            int fill;
-            int isnumok;
+            int r;
             PyObject* v = NULL;
-            PyObject* temp = NULL;
-            const char* pbuf;
-            int sign;
-            Py_ssize_t len;
-            char formatbuf[FORMATBUFLEN];
-/* For format{int,char}() */
 #ifdef Py_USING_UNICODE
             char* fmt_start = fmt;
             Py_ssize_t argidx_start = argidx;
@@ -825,214 +1471,22 @@ extern "C" PyObject* PyString_Format(PyObject* format, PyObject* args) noexcept
                 if (v == NULL)
                     goto error;
             }
-            sign = 0;
-            fill = ' ';
-            switch (c) {
-                case '%':
-                    pbuf = "%";
-                    len = 1;
-                    break;
-                case 's':
-#ifdef Py_USING_UNICODE
-                    if (PyUnicode_Check(v)) {
-                        fmt = fmt_start;
-                        argidx = argidx_start;
-                        goto unicode;
-                    }
-#endif
-                    temp = _PyObject_Str(v);
-#ifdef Py_USING_UNICODE
-                    if (temp != NULL && PyUnicode_Check(temp)) {
-                        Py_DECREF(temp);
-                        fmt = fmt_start;
-                        argidx = argidx_start;
-                        goto unicode;
-                    }
-#endif
-                /* Fall through */
-                case 'r':
-                    if (c == 'r')
-                        temp = PyObject_Repr(v);
-                    if (temp == NULL)
-                        goto error;
-                    if (!PyString_Check(temp)) {
-                        PyErr_SetString(PyExc_TypeError, "%s argument has non-string str()");
-                        Py_DECREF(temp);
-                        goto error;
-                    }
-                    pbuf = PyString_AS_STRING(temp);
-                    len = PyString_GET_SIZE(temp);
-                    if (prec >= 0 && len > prec)
-                        len = prec;
-                    break;
-                case 'i':
-                case 'd':
-                case 'u':
-                case 'o':
-                case 'x':
-                case 'X':
-                    if (c == 'i')
-                        c = 'd';
-                    isnumok = 0;
-                    if (PyNumber_Check(v)) {
-                        PyObject* iobj = NULL;
-
-                        if (PyInt_Check(v) || (PyLong_Check(v))) {
-                            iobj = v;
-                            Py_INCREF(iobj);
-                        } else {
-                            iobj = PyNumber_Int(v);
-                            if (iobj == NULL) {
-                                PyErr_Clear();
-                                iobj = PyNumber_Long(v);
-                            }
-                        }
-                        if (iobj != NULL) {
-                            if (PyInt_Check(iobj)) {
-                                isnumok = 1;
-                                pbuf = formatbuf;
-                                // Pyston change:
-                                len = formatint(formatbuf /* pbuf */, sizeof(formatbuf), flags, prec, c, iobj);
-                                Py_DECREF(iobj);
-                                if (len < 0)
-                                    goto error;
-                                sign = 1;
-                            } else if (PyLong_Check(iobj)) {
-                                int ilen;
-
-                                isnumok = 1;
-                                temp = _PyString_FormatLong(iobj, flags, prec, c, &pbuf, &ilen);
-                                Py_DECREF(iobj);
-                                len = ilen;
-                                if (!temp)
-                                    goto error;
-                                sign = 1;
-                            } else {
-                                Py_DECREF(iobj);
-                            }
-                        }
-                    }
-                    if (!isnumok) {
-                        PyErr_Format(PyExc_TypeError, "%%%c format: a number is required, "
-                                                      "not %.200s",
-                                     c, Py_TYPE(v)->tp_name);
-                        goto error;
-                    }
-                    if (flags & F_ZERO)
-                        fill = '0';
-                    break;
-                case 'e':
-                case 'E':
-                case 'f':
-                case 'F':
-                case 'g':
-                case 'G':
-                    temp = formatfloat(v, flags, prec, c);
-                    if (temp == NULL)
-                        goto error;
-                    pbuf = PyString_AS_STRING(temp);
-                    len = PyString_GET_SIZE(temp);
-                    sign = 1;
-                    if (flags & F_ZERO)
-                        fill = '0';
-                    break;
-                case 'c':
+            // Pyston change: moved the formatting of the argument to formatStrDirective.
+            r = formatStrDirective(&result, &res, &reslen, &rescnt, fmtcnt, flags, width, prec, c, v,
+                                   (Py_ssize_t)(fmt - 1 - PyString_AS_STRING(format)));
+            if (r < 0)
+                goto error;
 #ifdef Py_USING_UNICODE
-                    if (PyUnicode_Check(v)) {
-                        fmt = fmt_start;
-                        argidx = argidx_start;
-                        goto unicode;
-                    }
-#endif
-                    pbuf = formatbuf;
-                    // Pyston change:
-                    len = formatchar(formatbuf /* was pbuf */, sizeof(formatbuf), v);
-                    if (len < 0)
-                        goto error;
-                    break;
-                default:
-                    PyErr_Format(PyExc_ValueError, "unsupported format character '%c' (0x%x) "
-                                                   "at index %zd",
-                                 c, c, (Py_ssize_t)(fmt - 1 - PyString_AsString(format)));
-                    goto error;
-            }
-            if (sign) {
-                if (*pbuf == '-' || *pbuf == '+') {
-                    sign = *pbuf++;
-                    len--;
-                } else if (flags & F_SIGN)
-                    sign = '+';
-                else if (flags & F_BLANK)
-                    sign = ' ';
-                else
-                    sign = 0;
-            }
-            if (width < len)
-                width = len;
-            if (rescnt - (sign != 0) < width) {
-                reslen -= rescnt;
-                rescnt = width + fmtcnt + 100;
-                reslen += rescnt;
-                if (reslen < 0) {
-                    Py_DECREF(result);
-                    Py_XDECREF(temp);
-                    return PyErr_NoMemory();
-                }
-                if (_PyString_Resize(&result, reslen)) {
-                    Py_XDECREF(temp);
-                    return NULL;
-                }
-                res = PyString_AS_STRING(result) + reslen - rescnt;
-            }
-            if (sign) {
-                if (fill != ' ')
-                    *res++ = sign;
-                rescnt--;
-                if (width > len)
-                    width--;
-            }
-            if ((flags & F_ALT) && (c == 'x' || c == 'X')) {
-                assert(pbuf[0] == '0');
-                assert(pbuf[1] == c);
-                if (fill != ' ') {
-                    *res++ = *pbuf++;
-                    *res++ = *pbuf++;
-                }
-                rescnt -= 2;
-                width -= 2;
-                if (width < 0)
-                    width = 0;
-                len -= 2;
-            }
-            if (width > len && !(flags & F_LJUST)) {
-                do {
-                    --rescnt;
-                    *res++ = fill;
-                } while (--width > len);
-            }
-            if (fill == ' ') {
-                if (sign)
-                    *res++ = sign;
-                if ((flags & F_ALT) && (c == 'x' || c == 'X')) {
-                    assert(pbuf[0] == '0');
-                    assert(pbuf[1] == c);
-                    *res++ = *pbuf++;
-                    *res++ = *pbuf++;
-                }
-            }
-            Py_MEMCPY(res, pbuf, len);
-            res += len;
-            rescnt -= len;
-            while (--width >= len) {
-                --rescnt;
-                *res++ = ' ';
+            if (r == 0) {
+                fmt = fmt_start;
+                argidx = argidx_start;
+                goto unicode;
             }
+#endif
             if (dict && (argidx < arglen) && c != '%') {
                 PyErr_SetString(PyExc_TypeError, "not all arguments converted during string formatting");
-                Py_XDECREF(temp);
                 goto error;
             }
-            Py_XDECREF(temp);
         } /* '%' */
     }     /* until end */
     if (argidx < arglen && !dict) {
@@ -1052,48 +1506,11 @@ unicode:
         Py_DECREF(args);
         args_owned = 0;
     }
-    /* Fiddle args right (remove the first argidx arguments) */
-    if (PyTuple_Check(orig_args) && argidx > 0) {
-        PyObject* v;
-        Py_ssize_t n = PyTuple_GET_SIZE(orig_args) - argidx;
-        v = PyTuple_New(n);
-        if (v == NULL)
-            goto error;
-        while (--n >= 0) {
-            PyObject* w = PyTuple_GET_ITEM(orig_args, n + argidx);
-            Py_INCREF(w);
-            PyTuple_SET_ITEM(v, n, w);
-        }
-        args = v;
-    } else {
-        Py_INCREF(orig_args);
-        args = orig_args;
-    }
-    args_owned = 1;
-    /* Take what we have of the result and let the Unicode formatting
-       function format the rest of the input. */
-    rescnt = res - PyString_AS_STRING(result);
-    if (_PyString_Resize(&result, rescnt))
-        goto error;
-    fmtcnt = PyString_GET_SIZE(format) - (fmt - PyString_AS_STRING(format));
-    format = PyUnicode_Decode(fmt, fmtcnt, NULL, NULL);
-    if (format == NULL)
-        goto error;
-    v = PyUnicode_Format(format, args);
-    Py_DECREF(format);
-    if (v == NULL)
-        goto error;
-    /* Paste what we have (result) to what the Unicode formatting
-       function returned (v) and return the result (or error) */
-    w = PyUnicode_Concat(result, v);
-    Py_DECREF(result);
-    Py_DECREF(v);
-    Py_DECREF(args);
-    return w;
+    return formatStrRestAsUnicode(result, res, format, fmt, orig_args, argidx);
 #endif /* Py_USING_UNICODE */
 
 error:
-    Py_DECREF(result);
+    Py_XDECREF(result);
     if (args_owned) {
         Py_DECREF(args);
     }
@@ -2079,15 +2496,16 @@ template <ExceptionStyle S> static inline int stringContainsShared(BoxedString*
         }
     }
 
-    BoxedString* sub = static_cast<BoxedString*>(elt);
+    return strContainsStrCapi(self, static_cast<BoxedString*>(elt));
+}
 
-    size_t found_idx;
+// The str-in-str case of stringContainsShared; the compare IC calls this directly.
+extern "C" int strContainsStrCapi(BoxedString* self, BoxedString* sub) noexcept {
+    if (sub->size() == 0)
+        return 1;
     if (sub->size() == 1)
-        // Call the much-faster single-character find():
-        found_idx = self->s().find(sub->s()[0]);
-    else
-        found_idx = self->s().find(sub->s());
-    return (found_idx != std::string::npos);
+        return memchr(self->data(), sub->data()[0], self->size()) != NULL;
+    return memmem(self->data(), self->size(), sub->data(), sub->size()) != NULL;
 }
 
 // Analoguous to CPython's, used for sq_ slots.
@@ -2247,6 +2665,14 @@ Box* strEndswith(BoxedString* self, Box* elt, Box* start, Box** _args) {
     return boxBool(compareStringRefs(self->s(), istart, sub->size(), sub->s()) == 0);
 }
 
+// Whether PyUnicode_Decode() handles the encoding without going through the codec registry.
+static bool hasUnicodeDecodeShortcut(const char* encoding) {
+    if (!encoding)
+        encoding = PyUnicode_GetDefaultEncoding();
+    return strcmp(encoding, "utf-8") == 0 || strcmp(encoding, "UTF-8") == 0 || strcmp(encoding, "latin-1") == 0
+           || strcmp(encoding, "ascii") == 0;
+}
+
 Box* strDecode(BoxedString* self, Box* encoding, Box* error) {
     if (!PyString_Check(self))
         raiseExcHelper(TypeError, "descriptor 'decode' requires a 'str' object but received a '%s'", getTypeName(self));
@@ -2266,8 +2692,16 @@ Box* strDecode(BoxedString* self, Box* encoding, Box* error) {
     if (error_str && !PyString_Check(error_str))
         raiseExcHelper(TypeError, "decode() argument 2 must be string, not '%s'", getTypeName(error_str));
 
-    Box* result = PyString_AsDecodedObject(self, encoding_str ? encoding_str->data() : NULL,
-                                           error_str ? error_str->data() : NULL);
+    const char* encoding_data = encoding_str ? encoding_str->data() : NULL;
+    const char* error_data = error_str ? error_str->data() : NULL;
+
+    // For the codecs that unicode(s, encoding) has shortcuts for, decode the same way it does: this skips the codec
+    // registry, and ASCII-only strings are just widened (see PyUnicode_FromEncodedObject).
+    Box* result;
+    if (self->cls == str_cls && hasUnicodeDecodeShortcut(encoding_data))
+        result = PyUnicode_FromEncodedObject(self, encoding_data, error_data);
+    else
+        result = PyString_AsDecodedObject(self, encoding_data, error_data);
     if (!result)
         throwCAPIException();
     return result;
@@ -2459,6 +2893,49 @@ extern "C" int _PyString_Resize(PyObject** pv, Py_ssize_t newsize) noexcept {
     return 0;
 }
 
+// Rounds a string length up to the next of a series of sizes that grows by at most 25% per step.  Strings
+// that get appended to over and over are allocated with these sizes; once a string has reached one, realloc()
+// to the same size class is a no-op (pymalloc and libc both keep the block), so a string that grows to n bytes
+// only ever gets copied O(log n) times.
+static size_t strAppendCapacity(size_t n) {
+    if (n < 16)
+        return n;
+    size_t step = (size_t)1 << (63 - __builtin_clzl(n) - 2);
+    return (n + step - 1) & ~(step - 1);
+}
+
+extern "C" BoxedString* strAppendInPlace(BoxedString* lhs, BoxedString* rhs) noexcept {
+    assert(lhs->cls == str_cls);
+    assert(lhs->ob_refcnt == 1);
+    assert(!PyString_CHECK_INTERNED(lhs));
+    assert(lhs != rhs);
+
+    Py_ssize_t lhs_size = lhs->size();
+    Py_ssize_t rhs_size = rhs->size();
+    if (rhs_size > PY_SSIZE_T_MAX / 2 - PyStringObject_SIZE - lhs_size) {
+        PyErr_SetString(PyExc_OverflowError, "strings are too large to concat");
+        return NULL;
+    }
+
+    Py_ssize_t newsize = lhs_size + rhs_size;
+    _Py_DEC_REFTOTAL;
+    _Py_ForgetReference(lhs);
+    BoxedString* rtn = (BoxedString*)PyObject_REALLOC(lhs, PyStringObject_SIZE + strAppendCapacity(newsize));
+    if (!rtn) {
+        _Py_NewReference(lhs);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    _Py_NewReference(rtn);
+
+    memcpy(rtn->data() + lhs_size, rhs->data(), rhs_size);
+    rtn->ob_size = newsize;
+    rtn->data()[newsize] = '\0';
+    // The contents changed, so the cached hash is no longer valid.  The string was not interned and stays that way.
+    rtn->hash = -1;
+    return rtn;
+}
+
 extern "C" void PyString_Concat(register PyObject** pv, register PyObject* w) noexcept {
     if (*pv == NULL)
         return;
@@ -2716,14 +3193,14 @@ static PyBufferProcs string_as_buffer = {
 static PyMethodDef string_methods[] = {
     { "count", (PyCFunction)string_count, METH_O3 | METH_D2, NULL },
     { "join", (PyCFunction)string_join, METH_O, NULL },
-    { "split", (PyCFunction)string_split, METH_VARARGS, NULL },
-    { "rsplit", (PyCFunction)string_rsplit, METH_VARARGS, NULL },
-    { "find", (PyCFunction)string_find, METH_VARARGS, NULL },
-    { "index", (PyCFunction)string_index, METH_VARARGS, NULL },
+    { "split", (PyCFunction)string_split, METH_FASTCALL, NULL },
+    { "rsplit", (PyCFunction)string_rsplit, METH_FASTCALL, NULL },
+    { "find", (PyCFunction)string_find, METH_FASTCALL, NULL },
+    { "index", (PyCFunction)string_index, METH_FASTCALL, NULL },
     { "partition", (PyCFunction)string_partition, METH_O, NULL },
     { "rpartition", (PyCFunction)string_rpartition, METH_O, NULL },
-    { "rindex", (PyCFunction)string_rindex, METH_VARARGS, NULL },
-    { "rfind", (PyCFunction)string_rfind, METH_VARARGS, NULL },
+    { "rindex", (PyCFunction)string_rindex, METH_FASTCALL, NULL },
+    { "rfind", (PyCFunction)string_rfind, METH_FASTCALL, NULL },
     { "expandtabs", (PyCFunction)string_expandtabs, METH_VARARGS, NULL },
     { "replace", (PyCFunction)string_replace, METH_O3 | METH_D1, NULL },
     { "splitlines", (PyCFunction)string_splitlines, METH_VARARGS, NULL },
@@ -19,6 +19,7 @@
 #include "capi/types.h"
 #include "core/types.h"
 #include "runtime/objmodel.h"
+#include "runtime/rewrite_args.h"
 #include "runtime/types.h"
 
 namespace pyston {
@@ -63,12 +64,63 @@ public:
 
 static const char* class_str = "__class__";
 
-Box* superGetattribute(Box* _s, Box* _attr) {
-    RELEASE_ASSERT(_s->cls == super_cls, "");
-    BoxedSuper* s = static_cast<BoxedSuper*>(_s);
+// Looks up attr in the part of the mro that a super object refers to, ie the classes after s->type in the mro of
+// s->obj_type.  Returns a borrowed reference, or NULL if the attribute isn't there.
+static Box* superLookup(BoxedSuper* s, BoxedString* attr) {
+    PyObject* mro, *res, *tmp, *dict;
+    PyTypeObject* starttype;
+    Py_ssize_t i, n;
+
+    starttype = s->obj_type;
+    mro = starttype->tp_mro;
+
+    if (mro == NULL)
+        n = 0;
+    else {
+        assert(PyTuple_Check(mro));
+        n = PyTuple_GET_SIZE(mro);
+    }
+    for (i = 0; i < n; i++) {
+        if ((PyObject*)(s->type) == PyTuple_GET_ITEM(mro, i))
+            break;
+    }
+    i++;
+    res = NULL;
+    for (; i < n; i++) {
+        tmp = PyTuple_GET_ITEM(mro, i);
 
-    RELEASE_ASSERT(_attr->cls == str_cls, "");
-    BoxedString* attr = static_cast<BoxedString*>(_attr);
+// Pyston change:
+#if 0
+        if (PyType_Check(tmp))
+            dict = ((PyTypeObject *)tmp)->tp_dict;
+        else if (PyClass_Check(tmp))
+            dict = ((PyClassObject *)tmp)->cl_dict;
+        else
+            continue;
+        res = PyDict_GetItem(dict, name);
+#endif
+        res = tmp->getattr(attr);
+
+        if (res != NULL)
+            return res;
+    }
+    return NULL;
+}
+
+// If for_call is set, functions are returned unbound, with the instance stored in *bind_obj_out, the same way that
+// getattrInternalGeneric does it for normal objects.  This saves creating an instancemethod for each
+// super(C, self).method() call.
+//
+// The rewrite guards on the super object's type and obj_type, and on obj_type's version tag: since that tag changes
+// whenever any class in its mro is modified, the result of the mro walk can then be embedded as a constant, the same
+// way typeLookup does it.
+template <Rewritable rewritable>
+static Box* superGetattributeInternal(BoxedSuper* s, BoxedString* attr, GetattrRewriteArgs* rewrite_args,
+                                      bool for_call, BORROWED(Box**) bind_obj_out, RewriterVar** r_bind_obj_out) {
+    if (rewritable == NOT_REWRITABLE) {
+        assert(!rewrite_args);
+        rewrite_args = NULL;
+    }
 
     bool skip = s->obj_type == NULL;
 
@@ -78,63 +130,80 @@ Box* superGetattribute(Box* _s, Box* _attr) {
     }
 
     if (!skip) {
-        PyObject* mro, *res, *tmp, *dict;
-        PyTypeObject* starttype;
-        descrgetfunc f;
-        Py_ssize_t i, n;
-
-        starttype = s->obj_type;
-        mro = starttype->tp_mro;
-
-        if (mro == NULL)
-            n = 0;
-        else {
-            assert(PyTuple_Check(mro));
-            n = PyTuple_GET_SIZE(mro);
-        }
-        for (i = 0; i < n; i++) {
-            if ((PyObject*)(s->type) == PyTuple_GET_ITEM(mro, i))
-                break;
-        }
-        i++;
-        res = NULL;
-        for (; i < n; i++) {
-            tmp = PyTuple_GET_ITEM(mro, i);
+        Box* res = superLookup(s, attr);
 
+        if (res != NULL) {
 // Pyston change:
 #if 0
-            if (PyType_Check(tmp))
-                dict = ((PyTypeObject *)tmp)->tp_dict;
-            else if (PyClass_Check(tmp))
-                dict = ((PyClassObject *)tmp)->cl_dict;
-            else
-                continue;
-            res = PyDict_GetItem(dict, name);
+            Py_INCREF(res);
+            f = Py_TYPE(res)->tp_descr_get;
+            if (f != NULL) {
+                tmp = f(res,
+                    /* Only pass 'obj' param if
+                       this is instance-mode sper
+                       (See SF ID #743627)
+                    */
+                    (s->obj == (PyObject *)
+                                s->obj_type
+                        ? (PyObject *)NULL
+                        : s->obj),
+                    (PyObject *)starttype);
+                Py_DECREF(res);
+                res = tmp;
+            }
 #endif
-            res = tmp->getattr(attr);
+            bool instance_mode = (s->obj != s->obj_type);
+
+            RewriterVar* r_obj = NULL;
+            RewriterVar* r_obj_type = NULL;
+            if (rewrite_args) {
+                if (s->cls != super_cls || !PyType_HasFeature(s->obj_type, Py_TPFLAGS_VALID_VERSION_TAG)) {
+                    rewrite_args = NULL;
+                } else {
+                    static_assert(sizeof(BoxedClass::tp_flags) == 8, "addAttrGuard only supports 64bit values");
+                    static_assert(sizeof(BoxedClass::tp_version_tag) == 8, "addAttrGuard only supports 64bit values");
+                    Rewriter* rewriter = rewrite_args->rewriter;
+                    RewriterVar* r_s = rewrite_args->obj;
+                    r_s->addAttrGuard(offsetof(Box, cls), (intptr_t)super_cls);
+
+                    r_s->addAttrGuard(offsetof(BoxedSuper, type), (intptr_t)s->type);
+                    rewriter->addGCReference(s->type);
+
+                    r_obj_type = r_s->getAttr(offsetof(BoxedSuper, obj_type));
+                    r_obj_type->addGuard((intptr_t)s->obj_type);
+                    rewriter->addGCReference(s->obj_type);
+                    r_obj_type->addAttrGuard(offsetof(BoxedClass, tp_flags), (intptr_t)s->obj_type->tp_flags);
+                    r_obj_type->addAttrGuard(offsetof(BoxedClass, tp_version_tag),
+                                             (intptr_t)s->obj_type->tp_version_tag);
+
+                    r_obj = r_s->getAttr(offsetof(BoxedSuper, obj));
+                    if (instance_mode)
+                        r_obj->addGuardNotEq((intptr_t)s->obj_type);
+                    else
+                        r_obj->addGuard((intptr_t)s->obj_type);
+                }
+            }
 
-            if (res != NULL) {
-// Pyston change:
-#if 0
-                Py_INCREF(res);
-                f = Py_TYPE(res)->tp_descr_get;
-                if (f != NULL) {
-                    tmp = f(res,
-                        /* Only pass 'obj' param if
-                           this is instance-mode sper
-                           (See SF ID #743627)
-                        */
-                        (s->obj == (PyObject *)
-                                    s->obj_type
-                            ? (PyObject *)NULL
-                            : s->obj),
-                        (PyObject *)starttype);
-                    Py_DECREF(res);
-                    res = tmp;
+            if (for_call && instance_mode && res->cls == function_cls) {
+                if (rewrite_args) {
+                    RewriterVar* r_res = rewrite_args->rewriter->loadConst((intptr_t)res)->setType(RefType::BORROWED);
+                    rewrite_args->setReturn(r_res, ReturnConvention::HAS_RETURN);
+                    *r_bind_obj_out = r_obj;
                 }
-#endif
-                return processDescriptor(res, (s->obj == s->obj_type ? Py_None : s->obj), s->obj_type);
+                *bind_obj_out = s->obj;
+                return incref(res);
             }
+
+            Box* inst = instance_mode ? s->obj : Py_None;
+            Box* rtn = processDescriptor(res, inst, s->obj_type);
+            if (rewrite_args) {
+                RewriterVar* r_res = rewrite_args->rewriter->loadConst((intptr_t)res);
+                RewriterVar* r_inst = instance_mode ? r_obj : rewrite_args->rewriter->loadConst((intptr_t)Py_None);
+                RewriterVar* r_rtn = rewrite_args->rewriter->call(true, (void*)processDescriptor, r_res, r_inst,
+                                                                  r_obj_type)->setType(RefType::OWNED);
+                rewrite_args->setReturn(r_rtn, ReturnConvention::HAS_RETURN);
+            }
+            return rtn;
         }
     }
 
@@ -144,6 +213,16 @@ Box* superGetattribute(Box* _s, Box* _attr) {
     return rtn;
 }
 
+Box* superGetattribute(Box* _s, Box* _attr) {
+    RELEASE_ASSERT(_s->cls == super_cls, "");
+    BoxedSuper* s = static_cast<BoxedSuper*>(_s);
+
+    RELEASE_ASSERT(_attr->cls == str_cls, "");
+    BoxedString* attr = static_cast<BoxedString*>(_attr);
+
+    return superGetattributeInternal<NOT_REWRITABLE>(s, attr, NULL, false, NULL, NULL);
+}
+
 Box* super_getattro(Box* _s, Box* _attr) noexcept {
     try {
         return superGetattribute(_s, _attr);
@@ -153,6 +232,32 @@ Box* super_getattro(Box* _s, Box* _attr) noexcept {
     }
 }
 
+template <ExceptionStyle S>
+Box* superGetattroInternal(Box* _s, Box* _attr, GetattrRewriteArgs* rewrite_args, bool for_call,
+                           BORROWED(Box**) bind_obj_out, RewriterVar** r_bind_obj_out) noexcept(S == CAPI) {
+    STAT_TIMER(t0, "us_timer_super_getattro", 0);
+
+    BoxedSuper* s = static_cast<BoxedSuper*>(_s);
+    RELEASE_ASSERT(_attr->cls == str_cls, "");
+    BoxedString* attr = static_cast<BoxedString*>(_attr);
+
+    if (S == CAPI) {
+        try {
+            return superGetattributeInternal<REWRITABLE>(s, attr, rewrite_args, for_call, bind_obj_out,
+                                                         r_bind_obj_out);
+        } catch (ExcInfo e) {
+            setCAPIException(e);
+            return NULL;
+        }
+    } else {
+        return superGetattributeInternal<REWRITABLE>(s, attr, rewrite_args, for_call, bind_obj_out, r_bind_obj_out);
+    }
+}
+
+// Force instantiation of the template
+template Box* superGetattroInternal<CAPI>(Box*, Box*, GetattrRewriteArgs*, bool, Box**, RewriterVar**) noexcept;
+template Box* superGetattroInternal<CXX>(Box*, Box*, GetattrRewriteArgs*, bool, Box**, RewriterVar**);
+
 Box* superRepr(Box* _s) {
     RELEASE_ASSERT(_s->cls == super_cls, "");
     BoxedSuper* s = static_cast<BoxedSuper*>(_s);
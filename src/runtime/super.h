@@ -15,12 +15,21 @@
 #ifndef PYSTON_RUNTIME_SUPER_H
 #define PYSTON_RUNTIME_SUPER_H
 
+#include "core/types.h"
+
 namespace pyston {
 
 void setupSuper();
 
 class BoxedClass;
 extern BoxedClass* super_cls;
+
+class GetattrRewriteArgs;
+Box* super_getattro(Box* _s, Box* _attr) noexcept;
+template <ExceptionStyle S>
+Box* superGetattroInternal(Box* self, Box* attr, GetattrRewriteArgs* rewrite_args, bool for_call = false,
+                           BORROWED(Box**) bind_obj_out = NULL,
+                           RewriterVar** r_bind_obj_out = NULL) noexcept(S == CAPI);
 }
 
 #endif
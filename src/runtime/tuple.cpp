@@ -173,6 +173,7 @@ int BoxedTuple::Resize(BoxedTuple** pv, size_t newsize) noexcept {
         return -1;
     }
     _Py_NewReference((PyObject*)sv);
+    sv->hash = 0;
     /* Zero out items added by growing */
     if (newsize > oldsize)
         memset(&sv->elts[oldsize], 0, sizeof(*sv->elts) * (newsize - oldsize));
@@ -342,6 +343,24 @@ Box* tupleContains(BoxedTuple* self, Box* elt) {
     return boxBool(r);
 }
 
+// Versions of tuplecontains for exact int and str elements, which the compare IC calls directly.
+template <typename T> static int tupleContainsUnboxed(BoxedTuple* self, T* elt) noexcept {
+    for (Box* e : *self) {
+        int r = containsEltEq(elt, e);
+        if (r)
+            return r;
+    }
+    return 0;
+}
+
+extern "C" int tupleContainsIntCapi(BoxedTuple* self, BoxedInt* elt) noexcept {
+    return tupleContainsUnboxed(self, elt);
+}
+
+extern "C" int tupleContainsStrCapi(BoxedTuple* self, BoxedString* elt) noexcept {
+    return tupleContainsUnboxed(self, elt);
+}
+
 Box* tupleIndex(BoxedTuple* self, Box* elt, Box* startBox, Box** args) {
     Box* endBox = args[0];
 
@@ -469,6 +488,7 @@ extern "C" int PyTuple_SetItem(PyObject* op, Py_ssize_t i, STOLEN(PyObject*) new
 
     auto olditem = t->elts[i];
     t->elts[i] = newitem;
+    t->hash = 0;
     Py_XDECREF(olditem);
     return 0;
 }
@@ -505,17 +525,36 @@ extern "C" PyObject* PyTuple_New(Py_ssize_t size) noexcept {
 
 
 BoxedClass* tuple_iterator_cls = NULL;
+
+// Whether hash(o) only depends on the value of o, which makes it safe for a tuple containing o to cache its own hash.
+// o has just been hashed, so a nested tuple has already cached its hash if it could.
+static bool hasValueHash(Box* o) {
+    BoxedClass* cls = o->cls;
+    if (cls == str_cls || cls == int_cls || cls == unicode_cls || cls == long_cls || cls == float_cls
+        || cls == bool_cls || cls == none_cls)
+        return true;
+    return cls == tuple_cls && static_cast<BoxedTuple*>(o)->hash != 0;
+}
+
 static int64_t tuple_hash(BoxedTuple* v) noexcept {
+    // Pyston addition: tuples are immutable, so when all of the elements hash by value the result is cached.
+    // This is what makes tuples of strs and ints cheap to use repeatedly as dict and set keys.
+    if (v->hash != 0)
+        return v->hash;
+
     long x, y;
     Py_ssize_t len = Py_SIZE(v);
     PyObject** p;
     long mult = 1000003L;
+    bool cacheable = true;
     x = 0x345678L;
     p = v->elts;
     while (--len >= 0) {
-        y = PyObject_Hash(*p++);
+        y = PyObject_Hash(*p);
         if (y == -1)
             return -1;
+        cacheable = cacheable && hasValueHash(*p);
+        p++;
         x = (x ^ y) * mult;
         /* the cast might truncate len; that doesn't change hash stability */
         mult += (long)(82520L + len + len);
@@ -523,6 +562,8 @@ static int64_t tuple_hash(BoxedTuple* v) noexcept {
     x += 97531L;
     if (x == -1)
         x = -2;
+    if (cacheable)
+        v->hash = x;
     return x;
 }
 
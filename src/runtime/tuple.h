@@ -47,6 +47,8 @@ Box* tupleiterHasnext(Box* self);
 llvm_compat_bool tupleiterHasnextUnboxed(Box* self);
 Box* tupleiter_next(Box* self) noexcept;
 Box* tupleiterNext(Box* self);
+extern "C" int tupleContainsIntCapi(BoxedTuple* self, BoxedInt* elt) noexcept;
+extern "C" int tupleContainsStrCapi(BoxedTuple* self, BoxedString* elt) noexcept;
 }
 
 #endif
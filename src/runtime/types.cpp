@@ -108,15 +108,32 @@ extern "C" PyObject* PyType_GenericAlloc(PyTypeObject* type, Py_ssize_t nitems)
     /* note that we need to add one, for the sentinel */
     // I think that regardless of the reasoning behind them having it, we should do what they do?
 
+    // Pyston change: reserve space for the instance's attribute array at the end of the object, so that the common
+    // case of an object with a handful of attributes needs a single allocation.  The number of slots is learned in
+    // Box::appendNewHCAttr.
+    size_t alloc_size = size;
+    int inline_attrs = 0;
+    if ((type->tp_flags & Py_TPFLAGS_HEAPTYPE) && type->attrs_offset > 0 && type->tp_itemsize == 0) {
+        inline_attrs = type->instance_inline_attrs;
+        if (inline_attrs)
+            alloc_size += sizeof(HCAttrs::AttrList) + inline_attrs * sizeof(Box*);
+    }
+
     if (PyType_IS_GC(type))
-        obj = _PyObject_GC_Malloc(size);
+        obj = _PyObject_GC_Malloc(alloc_size);
     else
-        obj = (PyObject*)PyObject_MALLOC(size);
+        obj = (PyObject*)PyObject_MALLOC(alloc_size);
 
     if (obj == NULL)
         return PyErr_NoMemory();
 
-    memset(obj, '\0', size);
+    memset(obj, '\0', alloc_size);
+
+    if (inline_attrs) {
+        HCAttrs::AttrList* attr_list = (HCAttrs::AttrList*)((char*)obj + size);
+        attr_list->inline_capacity = inline_attrs;
+        ((HCAttrs*)((char*)obj + type->attrs_offset))->attr_list = attr_list;
+    }
 
     if (type->tp_flags & Py_TPFLAGS_HEAPTYPE)
         Py_INCREF(type);
@@ -2306,6 +2323,7 @@ private:
         HCAttrs* hcattrs = b->getHCAttrsPtr();
         // Skips the attrlist freelist:
         auto new_attr_list = (HCAttrs::AttrList*)PyObject_MALLOC(sizeof(HCAttrs::AttrList) + sizeof(Box*));
+        new_attr_list->inline_capacity = 0;
         new_attr_list->attrs[0] = d;
 
         hcattrs->hcls = HiddenClass::dict_backed;
@@ -2727,6 +2745,7 @@ public:
             ASSERT(rtn->d.count(p.first) == 0, "need to decref existing keys");
             rtn->d[incref(p.first)] = incref(attrs->attr_list->attrs[p.second]);
         }
+        rtn->keysChanged();
         return rtn;
     }
 
@@ -4738,6 +4757,7 @@ BORROWED(BoxedModule*) createModule(BoxedString* name, const char* fn, const cha
         module = new BoxedModule();
         autoDecref(moduleInit(module, name, autoDecref(boxString(doc ? doc : ""))));
         d->d[incref(name)] = module;
+        d->keysChanged();
     }
 
     if (fn)
@@ -4787,6 +4807,7 @@ extern "C" void Py_Finalize() noexcept {
     // initialized = 0;
 
     PyType_ClearCache();
+    clearStrFormatCache();
     clearAllICs();
     PyGC_Collect();
 
@@ -4820,6 +4841,7 @@ extern "C" void Py_Finalize() noexcept {
     constant_locations.clear();
 
     PyType_ClearCache();
+    clearStrFormatCache();
     PyOS_FiniInterrupts();
     _PyCodecRegistry_Deinit();
 
@@ -230,6 +230,11 @@ public:
     bool has_subclasscheck;
     bool has_getattribute;
 
+    // For heap types with hcattrs: how many attribute slots to reserve inside each new instance, so that the
+    // attribute array doesn't need its own allocation.  Learned in appendNewHCAttr from how many attributes earlier
+    // instances ended up with.  Fits in the padding after the flags above, so the C layout doesn't change.
+    uint8_t instance_inline_attrs;
+
     typedef llvm_compat_bool (*pyston_inquiry)(Box*);
 
     // tpp_descr_get is currently just a cache only for the use of tp_descr_get, and shouldn't
@@ -674,7 +679,14 @@ static_assert(offsetof(BoxedString, s_data) == offsetof(PyStringObject, ob_sval)
 
 size_t strHashUnboxedStrRef(llvm::StringRef str);
 extern "C" size_t strHashUnboxed(BoxedString* self);
+extern "C" int strContainsStrCapi(BoxedString* self, BoxedString* sub) noexcept;
 extern "C" int64_t hashUnboxed(Box* obj);
+// Appends rhs to lhs by growing lhs's storage, like realloc(): on success the returned string replaces lhs (which
+// might have moved), on failure NULL is returned with an exception set and lhs is left untouched.
+// lhs has to be an exact str, not interned, and the caller has to hold the only reference to it.
+extern "C" BoxedString* strAppendInPlace(BoxedString* lhs, BoxedString* rhs) noexcept;
+// Frees the compiled versions of the format strings that have been used with str %.
+void clearStrFormatCache();
 
 class BoxedInstanceMethod : public Box {
 public:
@@ -948,9 +960,9 @@ public:
     }
 
 private:
-    BoxedTuple() {}
+    BoxedTuple() : hash(0) {}
 
-    BoxedTuple(std::initializer_list<Box*>& members) {
+    BoxedTuple(std::initializer_list<Box*>& members) : hash(0) {
         // by the time we make it here elts[] is big enough to contain members
         Box** p = &elts[0];
         for (auto b : members) {
@@ -960,6 +972,10 @@ private:
     }
 
 public:
+    // The hash of the tuple, cached by tuple_hash if all of the elements have hashes that only depend on their
+    // values.  0 means not computed (or not cacheable): unlike -1 that's also what memory zeroed by tp_alloc holds.
+    long hash;
+
     // CPython declares ob_item (their version of elts) to have 1 element.  We want to
     // copy that behavior so that the sizes of the objects match, but we want to also
     // have a zero-length array in there since we have some extra compiler warnings turned
@@ -976,6 +992,7 @@ public:
 };
 static_assert(sizeof(BoxedTuple) == sizeof(PyTupleObject), "");
 static_assert(offsetof(BoxedTuple, ob_size) == offsetof(PyTupleObject, ob_size), "");
+static_assert(offsetof(BoxedTuple, hash) == offsetof(PyTupleObject, ob_hash), "");
 static_assert(offsetof(BoxedTuple, elts) == offsetof(PyTupleObject, ob_item), "");
 
 extern BoxedString* characters[UCHAR_MAX + 1];
@@ -1054,10 +1071,19 @@ public:
 
     DictMap d;
 
-    BoxedDict() __attribute__((visibility("default"))) {}
+    // Gets a new value, never used by any dict before, whenever a key is added or removed or the hash table gets
+    // reallocated -- but not when the value of an existing key is replaced.  So as long as it stays the same, a
+    // lookup of a given key finds the same bucket in d.  getGlobal() uses this to cache where a global lives.
+    // Anything that changes the set of keys in d directly has to call keysChanged().
+    uint64_t keys_version;
+
+    BoxedDict() __attribute__((visibility("default"))) : keys_version(++last_keys_version) {}
 
     DEFAULT_CLASS_SIMPLE(dict_cls, true);
 
+    void keysChanged() { keys_version = ++last_keys_version; }
+    static uint64_t last_keys_version;
+
     BORROWED(Box*) getOrNull(BoxAndHash k) {
         const auto& p = d.find(k);
         if (p != d.end())
@@ -62,6 +62,29 @@ extern "C" bool hasnext(Box* o);
 extern "C" void dump(void* p);
 extern "C" void dumpEx(void* p, int levels = 0);
 
+// Compares elt (an exact int or str) against an element of a list or tuple, for the `elt in seq` kernels.  Elements of
+// the same class get compared inline, anything else through the usual rich comparison.
+// Returns 1 if they are equal, 0 if not and -1 if an exception was set.
+inline int containsEltEq(BoxedInt* elt, Box* e) noexcept {
+    if (e->cls == int_cls)
+        return static_cast<BoxedInt*>(e)->n == elt->n;
+    return PyObject_RichCompareBool(elt, e, Py_EQ);
+}
+
+inline int containsEltEq(BoxedString* elt, Box* e) noexcept {
+    if (e == elt)
+        return 1;
+    if (e->cls == str_cls) {
+        BoxedString* s = static_cast<BoxedString*>(e);
+        if (s->size() != elt->size())
+            return 0;
+        if (s->hash != -1 && elt->hash != -1 && s->hash != elt->hash)
+            return 0;
+        return memcmp(s->data(), elt->data(), elt->size()) == 0;
+    }
+    return PyObject_RichCompareBool(elt, e, Py_EQ);
+}
+
 template <typename T> void copySlice(T* __restrict__ dst, const T* __restrict__ src, i64 start, i64 step, i64 length) {
     assert(dst != src);
     if (step == 1) {
@@ -59,11 +59,57 @@ dict_API_test(PyObject* self, PyObject* args) {
     return Py_BuildValue("OO", Py_None, Py_None);
 }
 
+// Calls back into the objects n times through the attribute C API functions, so that each call site sees
+// several different classes:
+static PyObject*
+capi_attrs_loop(PyObject* self, PyObject* args) {
+    PyObject *objs, *name, *results;
+    int n, i;
+    if (!PyArg_ParseTuple(args, "OSi", &objs, &name, &n))
+        return NULL;
+
+    results = PyList_New(0);
+    if (!results)
+        return NULL;
+    for (i = 0; i < n; i++) {
+        PyObject* o = PyList_GET_ITEM(objs, i % PyList_GET_SIZE(objs));
+        PyObject *a, *b, *c, *d, *e, *t;
+
+        a = PyObject_GetAttr(o, name);
+        if (!a)
+            PyErr_Clear();
+        b = PyObject_GetAttrString(o, "x");
+        if (!b)
+            PyErr_Clear();
+        c = PyObject_CallMethod(o, "f", NULL);
+        if (!c)
+            PyErr_Clear();
+        d = PyObject_CallMethod(o, "g", "(iiii)", 0, 1, 2, 3);
+        if (!d)
+            PyErr_Clear();
+        e = PyObject_CallMethodObjArgs(o, name, NULL);
+        if (!e)
+            PyErr_Clear();
+
+        t = Py_BuildValue("(NNNNN)", a ? a : PyString_FromString("<no attr>"), b ? b : PyString_FromString("<no x>"),
+                          c ? c : PyString_FromString("<no f>"), d ? d : PyString_FromString("<no g>"),
+                          e ? e : PyString_FromString("<not callable>"));
+        if (!t) {
+            Py_DECREF(results);
+            return NULL;
+        }
+        PyList_Append(results, t);
+        Py_DECREF(t);
+    }
+    return results;
+}
+
 static PyMethodDef TestMethods[] = {
     {"set_size",  set_size, METH_O, "Get set size by PySet_Size." },
     {"test_attrwrapper_parse",  test_attrwrapper_parse, METH_VARARGS, "Test PyArg_ParseTuple for attrwrappers." },
     {"change_self",  change_self, METH_VARARGS, "A function which the self point to its base class."},
     {"dict_API_test",  dict_API_test, METH_VARARGS, ""},
+    {"capi_attrs_loop",  capi_attrs_loop, METH_VARARGS, ""},
     {NULL, NULL, 0, NULL}        /* Sentinel */
 };
 
@@ -0,0 +1,92 @@
+# statcheck: noninit_count("num_varargs_passthrough") >= 3000
+# statcheck: noninit_count("num_kwargs_passthrough") >= 3000
+
+# Wrappers that forward *args and **kwargs unchanged get the incoming tuple passed through and the
+# dict copied in bulk; check that the callee still sees its own copy and that the cases that need
+# the slow path (named parameters, non-string keys, extra arguments) still behave the same.
+
+def target(*args, **kw):
+    return args, sorted(kw.items())
+
+def wrap1(*args, **kw):
+    return target(*args, **kw)
+
+def wrap2(*args, **kw):
+    return wrap1(*args, **kw)
+
+def wrap3(*args, **kw):
+    return wrap2(*args, **kw)
+
+for i in xrange(1000):
+    r = wrap3(1, 2, a=3, b=4)
+print r
+print wrap3()
+print wrap3(*(5, 6))
+print wrap3(**{'x': 1})
+
+# The callee must not be able to modify the caller's dict:
+def mutate(*args, **kw):
+    kw['added'] = True
+    kw.pop('a', None)
+    return kw
+
+d = {'a': 1, 'b': 2}
+for i in xrange(100):
+    r = mutate(**d)
+print sorted(r.items()), sorted(d.items())
+
+def fwd_mutate(**kw):
+    r = mutate(**kw)
+    return sorted(kw.items()), sorted(r.items())
+print fwd_mutate(a=1, c=3)
+
+# Some of the keys name parameters of the callee:
+def named(a, b=2, *args, **kw):
+    return a, b, args, sorted(kw.items())
+
+def wrap_named(*args, **kw):
+    return named(*args, **kw)
+
+print wrap_named(1, b=5, c=6)
+print wrap_named(a=1, c=6)
+print wrap_named(1, 2, 3, 4, c=6)
+try:
+    wrap_named(1, a=2)
+except TypeError as e:
+    print e
+
+# Extra arguments around the forwarded ones:
+def extra(*args, **kw):
+    return target(0, *args, z=26, **kw)
+print extra(1, 2, y=25)
+try:
+    extra(z=1)
+except TypeError as e:
+    print e
+
+# Non-string keys and non-dict mappings:
+try:
+    target(**{1: 2})
+except TypeError as e:
+    print e
+
+class Mapping(object):
+    def keys(self):
+        return ['m', 'n']
+    def __getitem__(self, k):
+        return k * 2
+print target(**Mapping())
+print named(1, **Mapping())
+
+class DictSub(dict):
+    pass
+print target(**DictSub(p=1, q=2))
+
+# Callees that don't take **kwargs:
+def nokw(*args):
+    return args
+try:
+    nokw(**{'a': 1})
+except TypeError as e:
+    print e
+print nokw(**{})
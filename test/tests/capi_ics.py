@@ -0,0 +1,68 @@
+# Attribute lookups and method calls made from C extensions through the C API go through per-caller runtime ICs;
+# make sure they handle different classes, attribute names and errors coming through the same C call site.
+
+import api_test
+
+class A(object):
+    x = "A.x"
+    def f(self):
+        return "A.f"
+    def g(self, *args):
+        return ("A.g", sum(args))
+    def h(self):
+        return "A.h"
+
+class B(A):
+    def __init__(self):
+        self.x = "B.x instance"
+    def f(self):
+        return "B.f"
+
+class C(object):
+    def __getattr__(self, attr):
+        if attr == "x":
+            return "C.x dynamic"
+        raise AttributeError(attr)
+
+class D:
+    x = "D.x"
+    def f(self):
+        return "D.f"
+    def g(self, a, b, c, d):
+        return ("D.g", a, b, c, d)
+
+class E(object):
+    f = staticmethod(lambda: "E.f")
+    g = classmethod(lambda cls, *args: (cls.__name__, len(args)))
+
+def show(t):
+    return tuple(("method " + v.__name__) if callable(v) else v for v in t)
+
+objs = [A(), B(), C(), D(), E(), 5, "str"]
+for name in ("h", "f", "x", "nonexistent"):
+    r = api_test.capi_attrs_loop(objs, name, 100)
+    print name
+    for t in r[:len(objs)]:
+        print show(t)
+    assert r[len(objs):2 * len(objs)] == r[:len(objs)]
+
+# Changing the classes after the ICs have been created:
+objs = [A(), B()]
+print map(show, api_test.capi_attrs_loop(objs, "h", 20)[-2:])
+A.h = lambda self: "new A.h"
+A.x = "new A.x"
+B.f = lambda self: "new B.f"
+print map(show, api_test.capi_attrs_loop(objs, "h", 20)[-2:])
+del A.g
+print map(show, api_test.capi_attrs_loop(objs, "h", 20)[-2:])
+
+# Lots of different names through the same call site:
+class Many(object):
+    pass
+m = Many()
+for i in xrange(100):
+    setattr(m, "attr%d" % i, i)
+t = 0
+for i in xrange(100):
+    t += api_test.capi_attrs_loop([m], "attr%d" % i, 2)[1][0]
+print t
@@ -0,0 +1,131 @@
+# Classes with a single (user-defined) base copy the slots they don't override from the base instead of recomputing
+# them; make sure the inherited and overridden behavior stays right, including when the bases change afterwards.
+
+class Base(object):
+    def __repr__(self):
+        return "<%s>" % type(self).__name__
+
+    def __len__(self):
+        return 3
+
+    def __getitem__(self, i):
+        if i >= 3:
+            raise IndexError(i)
+        return i * 10
+
+    def __add__(self, other):
+        return ("add", type(self).__name__)
+
+    def __eq__(self, other):
+        return type(self) is type(other)
+
+    def __hash__(self):
+        return 42
+
+    def __call__(self, *args):
+        return ("call", args)
+
+    def __iter__(self):
+        return iter([1, 2])
+
+class Plain(Base):
+    x = 1
+
+class Overrides(Base):
+    def __len__(self):
+        return 5
+
+    def __add__(self, other):
+        return "overridden add"
+
+    def __getattr__(self, attr):
+        return "missing " + attr
+
+class NoHash(Base):
+    __hash__ = None
+
+class Deep(Plain):
+    def __call__(self):
+        return "deep call"
+
+def describe(o):
+    r = [repr(o), len(o), o[1], o + 1, o == o, list(o)]
+    try:
+        r.append(hash(o))
+    except TypeError as e:
+        r.append(str(e))
+    try:
+        r.append(o())
+    except TypeError as e:
+        r.append(str(e))
+    r.append(getattr(o, "foo", "no foo"))
+    return r
+
+for cls in (Base, Plain, Overrides, NoHash, Deep):
+    print cls.__name__, describe(cls()), [c.__name__ for c in cls.__mro__]
+
+# Changing the base after the subclasses have been created:
+Base.__len__ = lambda self: 7
+Base.__getattr__ = lambda self, attr: "base missing " + attr
+for cls in (Base, Plain, Overrides, NoHash, Deep):
+    print cls.__name__, describe(cls())
+del Base.__getattr__
+print describe(Plain())
+
+# Slots defined on the subclass after creation:
+Plain.__len__ = lambda self: 11
+print len(Plain()), len(Deep()), len(Base())
+
+# Changing __bases__:
+class Other(object):
+    def __len__(self):
+        return 99
+class Switch(Plain):
+    pass
+print len(Switch()), [c.__name__ for c in Switch.__mro__]
+Switch.__bases__ = (Other,)
+print len(Switch()), [c.__name__ for c in Switch.__mro__]
+
+# Builtin bases, and a base with a custom mro:
+class MyList(list):
+    pass
+class MyList2(MyList):
+    def __len__(self):
+        return -1 + 2
+print len(MyList2([1, 2, 3])), MyList2([1]) + [2], MyList([4]) == [4]
+
+class Meta(type):
+    def mro(cls):
+        return [cls, Other, object] if cls.__name__ == "Reordered" else type.mro(cls)
+class WithMeta(object):
+    __metaclass__ = Meta
+    def __len__(self):
+        return 1
+class Reordered(WithMeta):
+    pass
+print len(WithMeta()), len(Reordered()), [c.__name__ for c in Reordered.__mro__]
+
+# Descriptors and iterators:
+class Desc(object):
+    def __get__(self, obj, type):
+        return "got"
+class SubDesc(Desc):
+    pass
+class Holder(object):
+    d = SubDesc()
+print Holder().d
+
+class It(object):
+    def __iter__(self):
+        return self
+    def next(self):
+        raise StopIteration
+class SubIt(It):
+    pass
+print list(SubIt())
+
+# Lots of classes, created in a loop:
+classes = []
+for i in xrange(200):
+    classes.append(type("C%d" % i, (classes[-1] if classes and i % 10 else Base,), {"n": i}))
+print len(classes[-1]()), classes[-1].n, len(classes[-1].__mro__)
@@ -0,0 +1,90 @@
+# `x in container` gets specialized for ints and strs in lists, tuples, sets, dicts and strs; check that the
+# specialized versions agree with the generic ones, including for elements of other classes.
+
+def f(x, c):
+    return x in c, x not in c
+
+class Eq(object):
+    def __init__(self, v):
+        self.v = v
+    def __eq__(self, other):
+        return self.v == other
+    def __hash__(self):
+        return hash(self.v)
+
+class S(str):
+    pass
+
+class Raises(object):
+    def __eq__(self, other):
+        raise ValueError("eq")
+    def __hash__(self):
+        return hash(1)
+
+containers = [
+    [1, 2, 3],
+    [1.0, 2L, True],
+    [Eq(5), "a"],
+    [S("abc"), u"b"],
+    (1, 2, 3),
+    (3.0, "x", Eq("y")),
+    (),
+    set([1, 2, "a"]),
+    frozenset([1.0, u"b", Eq(7)]),
+    {"a": 1, 2: "b", u"b": 3},
+    {Eq("c"): 1},
+    "abcabd",
+    "",
+]
+elts = [1, 2, 3, 5, 7, 0, "a", "b", "c", "x", "y", "abc", "abd", "bca", "", "bd", "da", 1L, True, 3.0]
+
+for i in xrange(3):
+    r = []
+    for c in containers:
+        for x in elts:
+            try:
+                r.append(f(x, c))
+            except TypeError as e:
+                r.append(str(e))
+    print r
+
+# Elements whose comparisons throw:
+for c in ([Raises(), 1], (Raises(), "a"), set([Raises()]), {Raises(): 1}):
+    for x in (1, "a"):
+        try:
+            print f(x, c)
+        except ValueError as e:
+            print "ValueError", e
+
+# Comparisons that shrink the list:
+class Shrink(object):
+    def __init__(self, l):
+        self.l = l
+    def __eq__(self, other):
+        del self.l[:]
+        return False
+for i in xrange(3):
+    l = [0]
+    l[:] = [Shrink(l), 1, 2, 3]
+    print f(3, l), l
+
+# Strings in strings:
+haystack = "the quick brown fox jumps over the lazy dog" * 3
+for i in xrange(3):
+    print [f(s, haystack)[0] for s in ("the", "dog", "dogthe", "z", "q", "", "lazy dog" * 2, haystack, haystack + " ")]
+    print f("\0", "a\0b"), f("a\0c", "a\0b"), f(u"b", "abc"), f(S("ab"), "abc")
+
+# Sets and dicts getting modified between lookups:
+s = set()
+d = {}
+for i in xrange(20):
+    k = "k%d" % (i % 5)
+    print f(k, s)[0], f(k, d)[0], f(i, s)[0],
+    if i % 3 == 0:
+        s.add(k)
+        d[k] = i
+        s.add(i)
+    elif i % 3 == 1:
+        s.discard("k%d" % ((i + 2) % 5))
+        d.pop("k%d" % ((i + 2) % 5), None)
+print
@@ -0,0 +1,139 @@
+# d[k] and d[k] = v with a str key on a plain dict go through a special path that remembers which bucket the key was
+# found in; make sure it notices when the set of keys in the dict changes.
+
+def get(d):
+    return d["a"]
+
+def put(d, v):
+    d["a"] = v
+
+d = {"a": 1, "b": 2}
+t = 0
+for i in xrange(1000):
+    put(d, i)
+    t += get(d)
+print t, sorted(d.items())
+
+# Missing keys:
+for i in xrange(5):
+    d = {"b": 1} if i % 2 else {"a": i}
+    try:
+        r = get(d)
+    except KeyError as e:
+        r = "KeyError " + repr(e)
+    print i, r
+
+# Deleting and re-adding the key, and adding enough other keys to make the dict get reallocated:
+d = {}
+for i in xrange(100):
+    put(d, i)
+    assert get(d) == i
+    if i % 3 == 0:
+        del d["a"]
+        try:
+            get(d)
+            assert 0
+        except KeyError:
+            pass
+        put(d, -i)
+        assert get(d) == -i
+    d["k%d" % i] = i
+print len(d), get(d)
+
+d = {"a": 1}
+for i in xrange(20):
+    print get(d),
+    if i == 5:
+        d.clear()
+        d["a"] = "cleared"
+    if i == 10:
+        d.pop("a")
+        d.update({"a": "updated"})
+    if i == 15:
+        d.setdefault("z", 0)
+        d["a"] = "again"
+print
+
+# Keys that are equal to, but not the same object as, the key used for the lookup:
+key = "".join(["a"])
+for i in xrange(5):
+    d = {key + "": i}
+    put(d, d["a"] + 1)
+    print d, get(d)
+
+# Lots of different dicts at the same call site:
+ds = [{"a": i} for i in xrange(200)]
+for n in xrange(3):
+    print sum(get(d) for d in ds)
+    for d in ds:
+        put(d, get(d) + 1)
+
+# Other key objects that compare (and hash) equal to the string:
+class K(object):
+    def __init__(self, s):
+        self.s = s
+    def __hash__(self):
+        return hash(self.s)
+    def __eq__(self, other):
+        return self.s == other
+d = {K("a"): "K"}
+for i in xrange(3):
+    print get(d),
+    put(d, i)
+print len(d), sorted(d.values())
+
+# Keys whose __eq__ modifies the dict during the lookup:
+class Evil(object):
+    def __init__(self, d):
+        self.d = d
+    def __hash__(self):
+        return hash("a")
+    def __eq__(self, other):
+        self.d.pop("x", None)
+        return False
+for i in xrange(5):
+    d = {"x": 1}
+    d[Evil(d)] = 2
+    put(d, i)
+    print get(d), len(d)
+
+# Subclasses (with __missing__) don't use the special path:
+class D(dict):
+    def __missing__(self, k):
+        return "missing " + k
+class E(dict):
+    def __getitem__(self, k):
+        return "E " + k
+    def __setitem__(self, k, v):
+        dict.__setitem__(self, k, v * 2)
+for i in xrange(3):
+    for d in ({}, D(), E()):
+        try:
+            r = get(d)
+        except KeyError as e:
+            r = "KeyError"
+        put(d, i)
+        print type(d).__name__, r, get(d), dict.__getitem__(d, "a")
+
+# str subclasses and unicode keys:
+class S(str):
+    pass
+def get2(d, k):
+    return d[k]
+for i in xrange(3):
+    d = {"a": 1, u"b": 2}
+    print get2(d, "a"), get2(d, S("a")), get2(d, "b"), get2(d, u"a")
+    d[S("a")] = 3
+    d[u"b"] = 4
+    print sorted(d.items())
+
+# Values whose destructors modify the dict when they get replaced:
+class Dtor(object):
+    def __init__(self, d):
+        self.d = d
+    def __del__(self):
+        self.d["b%d" % len(self.d)] = 1
+d = {}
+for i in xrange(10):
+    put(d, Dtor(d))
+print len(d)
@@ -0,0 +1,80 @@
+# str.split/find/..., list.sort and some heapq functions receive their arguments as an array
+# (METH_FASTCALL) rather than as a tuple; make sure every way of calling them still works.
+import heapq
+
+def catch(f):
+    try:
+        return f()
+    except Exception as e:
+        return "%s: %s" % (type(e).__name__, e)
+
+def run():
+    r = []
+    s = "hello world, hello"
+    r.append(s.find("hello"))
+    r.append(s.find("hello", 1))
+    r.append(s.find("hello", 1, 10))
+    r.append(s.find("hello", None, None))
+    r.append(s.rfind("hello"))
+    r.append(s.rfind("hello", 0, 10))
+    r.append(s.index("world"))
+    r.append(s.rindex("l", -3))
+    r.append(s.find(u"world"))
+    r.append(str.find(s, "o", 5))
+    r.append(s.find(*("o", 5)))
+    r.append(s.split())
+    r.append(s.split(None, 1))
+    r.append(s.split(","))
+    r.append(s.rsplit(" ", 1))
+    r.append(str.split(s, "l", 2))
+    r.append(s.split(*[" "]))
+    r.append(catch(lambda: s.find()))
+    r.append(catch(lambda: s.find("a", 1, 2, 3)))
+    r.append(catch(lambda: s.find(1)))
+    r.append(catch(lambda: s.index("xyz")))
+    r.append(catch(lambda: s.split(" ", "x")))
+
+    l = [3, 1, 2]
+    l.sort()
+    r.append(l[:])
+    l.sort(reverse=True)
+    r.append(l[:])
+    l.sort(key=lambda x: -x, reverse=False)
+    r.append(l[:])
+    l.sort(None, None, True)
+    r.append(l[:])
+    l.sort(lambda a, b: cmp(a, b), reverse=1)
+    r.append(l[:])
+    l.sort(**{"reverse": False})
+    r.append(l[:])
+    l.sort(**{u"reverse": True})
+    r.append(l[:])
+    list.sort(l, key=str)
+    r.append(l[:])
+    r.append(sorted([3, 1, 2], key=lambda x: x % 3, reverse=True))
+    r.append(sorted([3, 1, 2]))
+    r.append(catch(lambda: l.sort(foo=1)))
+    r.append(catch(lambda: l.sort(None, cmp=None)))
+    r.append(catch(lambda: l.sort(1, 2, 3, 4)))
+    r.append(catch(lambda: l.sort(reverse=1.5)))
+    r.append(catch(lambda: l.sort(reverse="x")))
+    r.append(catch(lambda: l.sort(reverse=1, **{"reverse": 0})))
+
+    h = []
+    for i in (5, 3, 8, 1):
+        heapq.heappush(h, i)
+    r.append(h[:])
+    r.append(heapq.heappushpop(h, 4))
+    r.append(heapq.heapreplace(h, 0))
+    r.append(heapq.heappushpop(*(h, 10)))
+    r.append(h[:])
+    r.append(catch(lambda: heapq.heappush(h)))
+    r.append(catch(lambda: heapq.heappush(h, 1, 2)))
+    r.append(catch(lambda: heapq.heappush(None, 1)))
+    return r
+
+first = run()
+for x in first:
+    print x
+for i in range(100):
+    assert run() == first
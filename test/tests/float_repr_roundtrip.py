@@ -0,0 +1,39 @@
+# repr, str and float() have fast paths for the common cases; they have to give
+# exactly the same results as the exact conversions they fall back to.
+
+import random
+import struct
+
+random.seed(12345)
+
+values = [0.0, -0.0, 0.1, 0.2, 0.3, 0.1 + 0.2, 1.0 / 3, 2.0 / 3, 1e16, 1e17, 2e16 + 8, 1e22, 1e23,
+          123456789012345678.0, 5e-324, 2.2250738585072014e-308, 2.2250738585072009e-308,
+          1.7976931348623157e308, 9007199254740993.0, 0.5, 2.5, 1e-4, 1e-5, 12345.678, 2 ** 60 + 0.0,
+          2.0 ** -1022, 2.0 ** -1074, 2.0 ** 1023, 4.35, 0.15, 1.005, 1234567.0, 123456789012.0]
+for i in xrange(300):
+    values.append(struct.unpack('d', struct.pack('Q', random.getrandbits(64)))[0])
+    values.append(random.random() * 10 ** random.randint(-20, 20))
+    values.append(round(random.uniform(-1000, 1000), random.randint(0, 6)))
+    values.append(random.choice([1, -1]) * 2.0 ** random.randint(-1074, 1023))
+
+for v in values:
+    if v != v:
+        continue
+    r = repr(v)
+    assert float(r) == v, r
+    print r, str(v), '%.17g' % v, '%.3e' % v, '%g' % v
+
+strings = ["9007199254740993", "1e23", "8.589973e9", "2.2250738585072011e-308", "4.9e-324", "1e-400",
+           "1e400", "1.7976931348623159e308", ".5", "5.", "-0", "0e999999", "1e0009", "1234567890123456789",
+           "12345678901234567890", "1.00000000000000011102230246251565404236316680908203125",
+           "1.00000000000000011102230246251565404236316680908203124", "  1.5  ", "4503599627370496.5",
+           "4503599627370497.5", "123456789e-30", "6.9294956446009195e15", "3.4e-320", "-.25E+2"]
+for s in strings:
+    print repr(s), repr(float(s))
+
+for s in ["1e", "1e+", ".", "", "0x10", "1.5x", "1.5e5.3", "e5", "--1"]:
+    try:
+        float(s)
+        print s, "parsed"
+    except ValueError as e:
+        print e
@@ -0,0 +1,24 @@
+# The results of scanning PyArg_ParseTuple(AndKeywords) format strings get cached; make sure the argument
+# handling and error messages stay the same when the same format strings are used repeatedly.
+import struct
+import binascii
+
+s = struct.Struct("<hi")
+buf = s.pack(1, 2) + "xxxx"
+for i in xrange(3):
+    print s.unpack_from(buf), s.unpack_from(buf, 2), s.unpack_from(buf, offset=0), s.unpack_from(buffer=buf)
+    print struct.unpack_from("<h", buf, 2), struct.unpack_from("<h", buffer=buf, offset=4)
+    print binascii.crc32("abc"), binascii.crc32("abc", 5), binascii.hexlify("ab")
+    for f in (lambda: s.unpack_from(), lambda: s.unpack_from(buf, offset=1, other=2),
+              lambda: s.unpack_from(buf, 0, offset=0), lambda: s.unpack_from(buf, "x"),
+              lambda: s.unpack_from(buf, 0, 1), lambda: binascii.crc32(), lambda: binascii.crc32("a", "b"),
+              lambda: struct.Struct(fmt="<h", x=1), lambda: struct.unpack_from("<h", buf, offset=100)):
+        try:
+            f()
+        except (TypeError, struct.error) as e:
+            print type(e).__name__, e
+
+# Keyword arguments passed with different string objects that have the same contents:
+name = "".join(["off", "set"])
+for i in xrange(3):
+    print s.unpack_from(buf, **{name: 2}), s.unpack_from(buf, **{"offset": 0})
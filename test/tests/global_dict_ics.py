@@ -0,0 +1,19 @@
+# run_args: -n
+# statcheck: noninit_count("slowpath_getglobal") <= 20
+
+# Loads of globals from a dict (and of builtins through it) get ICs; storing
+# to an existing global doesn't invalidate them.
+d = dict(x=1, y=0)
+exec """
+def g():
+    global y
+    y += x + len("")
+""" in d
+
+g = d['g']
+n = 1000
+while n:
+    g()
+    d['x'] += 1
+    n = n - 1
+print d['y']
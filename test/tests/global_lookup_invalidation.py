@@ -0,0 +1,61 @@
+# Global lookups are cached per call site; make sure that the caches notice
+# globals being added, rebound and deleted, both for module globals and for
+# code exec'd in a dict, including names that shadow builtins.
+
+def f():
+    return len, x
+
+x = 1
+for i in range(2000):
+    r = f()
+    if i == 500:
+        x = 2
+    if i == 1000:
+        len = lambda o: -1
+    if i == 1500:
+        del len
+        y = 5
+    if i in (499, 501, 999, 1001, 1499, 1501):
+        print i, r[0]("ab"), r[1]
+
+d = dict(x=1)
+exec """
+def g():
+    return len("abc"), x
+""" in d
+g = d['g']
+for i in range(2000):
+    r = g()
+    if i == 300:
+        d['x'] = 10
+    if i == 600:
+        d['len'] = lambda o: 42
+    if i == 900:
+        for n in range(100):
+            d['filler%d' % n] = n
+    if i == 1200:
+        del d['len']
+    if i == 1500:
+        del d['x']
+        try:
+            g()
+        except NameError as e:
+            print e
+        d['x'] = 20
+    if i == 1800:
+        d.update({'x': 30, 'len': bool})
+    if i % 300 in (299, 1):
+        print i, r
+
+# Adding unrelated globals (or going through globals()) shouldn't break anything either.
+def h():
+    return z
+
+z = "z"
+for i in range(1000):
+    r = h()
+    if i % 100 == 0:
+        globals()["unrelated%d" % i] = i
+    if i == 700:
+        globals()["z"] = "z2"
+print r
@@ -0,0 +1,114 @@
+# Instances of user-defined classes keep their first few attributes in slots allocated together with the object
+# (the number of slots is learned from earlier instances).  Exercise growing past those slots, and the various
+# ways the attribute storage can get replaced.
+
+class C(object):
+    pass
+
+def fill(o, n):
+    for i in xrange(n):
+        setattr(o, "a%d" % i, i)
+
+def show(o):
+    return sorted(o.__dict__.items())
+
+# Instances with increasing numbers of attributes, so that later instances get more inline slots than
+# earlier ones, and then fewer again:
+objs = []
+for n in range(25) + range(25)[::-1]:
+    o = C()
+    fill(o, n)
+    objs.append((n, o))
+for n, o in objs:
+    assert len(o.__dict__) == n, (n, o.__dict__)
+    for i in xrange(n):
+        assert getattr(o, "a%d" % i) == i
+print len(objs)
+
+# Setting attributes in a loop, so that the set goes through the IC:
+def f(o):
+    o.x = 1
+    o.y = 2
+    o.z = 3
+    o.w = 4
+    o.v = 5
+for i in xrange(1000):
+    o = C()
+    f(o)
+    if i % 7 == 0:
+        o.extra = i
+    assert o.x + o.y + o.z + o.w + o.v == 15
+print show(o)
+
+# Deleting and re-adding attributes:
+o = C()
+fill(o, 6)
+del o.a0
+del o.a3
+o.a0 = "new"
+o.b = "b"
+print show(o)
+for i in xrange(20):
+    o.__dict__["k%d" % i] = i
+print len(o.__dict__), o.k19
+
+# Replacing or clearing __dict__:
+o = C()
+fill(o, 3)
+d = o.__dict__
+o.__dict__ = {"q": 1}
+print show(o), sorted(d.items())
+o.r = 2
+print show(o)
+
+o = C()
+fill(o, 4)
+o.__dict__.clear()
+print show(o)
+fill(o, 8)
+print show(o)
+
+# Non-string keys force the object over to a real dict:
+o = C()
+fill(o, 2)
+o.__dict__[1] = "one"
+o.x = "x"
+print sorted(o.__dict__.items())
+
+# Changing the class of an instance:
+class D(object):
+    pass
+o = C()
+fill(o, 5)
+o.__class__ = D
+o.extra = 1
+print type(o).__name__, show(o)
+for i in xrange(10):
+    d = D()
+    d.__class__ = C
+    fill(d, i)
+print show(d)
+
+# Subclasses (including ones with __slots__, which makes the instances bigger):
+class E(C):
+    pass
+class F(C):
+    __slots__ = ("s",)
+for cls in (E, F):
+    for i in xrange(10):
+        o = cls()
+        fill(o, i)
+    o.s = "slot"
+    print cls.__name__, show(o), o.s
+
+# Reference cycles, so that the objects (and their inline slots) get freed by the GC:
+import gc
+for i in xrange(100):
+    a = C()
+    b = C()
+    a.other = b
+    b.other = a
+    fill(a, i % 10)
+del a, b
+gc.collect()
+print "done"
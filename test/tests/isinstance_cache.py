@@ -0,0 +1,133 @@
+# isinstance() and issubclass() results get cached (and folded into ICs) when they only depend on the classes
+# involved; check that they get recomputed when those classes change.
+
+import abc
+import collections
+
+class A(object):
+    pass
+class B(A):
+    pass
+class C(object):
+    pass
+
+def check(o, t):
+    return isinstance(o, t)
+
+def subcheck(c, t):
+    return issubclass(c, t)
+
+objs = [A(), B(), C(), 1, "s", [], {}, ()]
+targets = [A, B, C, int, object, collections.Sized, collections.Iterable, collections.Hashable,
+           collections.Mapping, collections.Sequence]
+for i in xrange(20):
+    r = [[check(o, t) for t in targets] for o in objs]
+    r2 = [[subcheck(type(o), t) for t in targets] for o in objs]
+print r
+print r2
+
+# Registering with an ABC after a negative result:
+class MyABC(object):
+    __metaclass__ = abc.ABCMeta
+class D(object):
+    pass
+d = D()
+for i in xrange(5):
+    print i, check(d, MyABC), subcheck(D, MyABC), check(d, collections.Sized)
+    if i == 1:
+        MyABC.register(D)
+
+# Registering a base class:
+class E(object):
+    pass
+class F(E):
+    pass
+f = F()
+for i in xrange(5):
+    print i, check(f, MyABC), subcheck(F, MyABC)
+    if i == 2:
+        MyABC.register(E)
+
+# Subclass hooks:
+class HasFoo(object):
+    __metaclass__ = abc.ABCMeta
+    @classmethod
+    def __subclasshook__(cls, C):
+        if any("foo" in B.__dict__ for B in C.__mro__):
+            return True
+        return NotImplemented
+class G(object):
+    def foo(self):
+        pass
+class H(object):
+    pass
+for i in xrange(5):
+    print i, check(G(), HasFoo), check(H(), HasFoo), subcheck(H, HasFoo)
+
+# Changing the bases of a class:
+class I(object):
+    pass
+class J(object):
+    pass
+class K(I):
+    pass
+k = K()
+for i in xrange(5):
+    print i, check(k, I), check(k, J), subcheck(K, J)
+    if i == 2:
+        K.__bases__ = (J,)
+
+# A custom metaclass whose answer depends on the instance, which mustn't get cached:
+class Meta(type):
+    def __instancecheck__(self, inst):
+        return getattr(inst, "yes", False)
+class L(object):
+    __metaclass__ = Meta
+class M(object):
+    pass
+m = M()
+for i in xrange(5):
+    print i, check(m, L)
+    m.yes = (i % 2 == 0)
+
+# An ABCMeta subclass that overrides the check:
+class MetaABC(abc.ABCMeta):
+    def __instancecheck__(self, inst):
+        return getattr(inst, "yes", False)
+class N(object):
+    __metaclass__ = MetaABC
+for i in xrange(5):
+    print i, check(m, N)
+    m.yes = (i % 2 == 1)
+
+# Objects that lie about their __class__:
+class Liar(object):
+    @property
+    def __class__(self):
+        return A
+for i in xrange(3):
+    print check(Liar(), A), check(Liar(), MyABC)
+
+# Old-style classes and instances:
+class O:
+    pass
+class P(O):
+    pass
+for i in xrange(3):
+    print check(P(), O), check(P(), A), subcheck(P, O), check(O(), MyABC)
+
+# A check that raises, from a site that can't be folded:
+class Boom(type):
+    def __instancecheck__(self, inst):
+        if getattr(inst, "boom", False):
+            raise ValueError("boom")
+        return True
+class Q(object):
+    __metaclass__ = Boom
+for i in xrange(6):
+    m.boom = (i % 3 == 2)
+    try:
+        r = check(m, Q)
+    except ValueError as e:
+        r = "raised %s" % e
+    print i, r
@@ -0,0 +1,55 @@
+# Keyword arguments get bound through a per-function cache of where each call site's keywords go;
+# make sure calls still bind (and fail) the same way no matter which call site populated it.
+
+def f(a, b=2, c=3, d=4, e=5, f=6, g=7):
+    return (a, b, c, d, e, f, g)
+
+def kw(a, b=2, **kw):
+    return (a, b, sorted(kw.items()))
+
+def call_all():
+    r = []
+    r.append(f(1, g=70, b=20))
+    r.append(f(a=1, g=70, b=20))
+    r.append(f(1, 2, 3, e=50))
+    r.append(f(e=50, d=40, c=30, b=20, a=10))
+    r.append(kw(1, b=5))
+    r.append(kw(1, z=26, b=5))
+    r.append(kw(a=1, y=25, z=26))
+
+    for fn, args, kwargs in [(lambda: f(1, a=1), None, None),
+                             (lambda: f(1, 2, b=3), None, None),
+                             (lambda: f(1, h=8), None, None),
+                             (lambda: f(b=1), None, None),
+                             (lambda: kw(1, 2, b=3), None, None),
+                             (lambda: kw(1, a=1, x=1), None, None)]:
+        try:
+            fn()
+            r.append("no error")
+        except TypeError as e:
+            r.append(str(e))
+    return r
+
+first = call_all()
+for l in first:
+    print l
+for i in range(100):
+    assert call_all() == first
+
+# Lots of different keyword combinations for the same function:
+import itertools
+names = ["b", "c", "d", "e", "f", "g"]
+for n in range(1, 4):
+    for combo in itertools.permutations(names, n):
+        s = "f(0, %s)" % ", ".join("%s=%r" % (name, name.upper()) for name in combo)
+        r = eval(s)
+        for i in range(3):
+            assert eval(s) == r
+        if n < 3:
+            print s, r
+
+# Keyword names that aren't interned, and **kwargs passed into named parameters:
+for i in range(5):
+    d = {"".join(["g"]): 1, "b" + "": 2}
+    print f(0, **d), kw(0, **d)
+    print sorted([3, 1, 2], reverse=True, key=lambda x: -x)
@@ -0,0 +1,37 @@
+# statcheck: noninit_count('slowpath_getitem') <= 20
+# statcheck: noninit_count('slowpath_setitem') <= 20
+
+# list[int] and list[int] = v get their own IC fast path; exercise the edge cases through it.
+
+def get(l, i):
+    try:
+        return l[i]
+    except IndexError as e:
+        return e
+
+def set(l, i, v):
+    try:
+        l[i] = v
+    except IndexError as e:
+        return e
+
+l = range(5)
+for i in xrange(1000):
+    n = i % 14 - 7
+    r = get(l, n)
+    set(l, n, r)
+print l
+print get(l, 5), get(l, -6)
+print set(l, 5, 0), set(l, -6, 0)
+
+class L(list):
+    def __getitem__(self, idx):
+        return "L", idx
+    def __setitem__(self, idx, v):
+        print "set", idx, v
+
+for i in xrange(100):
+    r = get(l if i % 2 else L(), i % 3)
+    set(l if i % 2 else L(), 0, i)
+print r, l
+print get(l, True), get([1, 2], 1L)
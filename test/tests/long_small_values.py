@@ -0,0 +1,42 @@
+# Longs that fit in 128 bits are handled without GMP; check the results around the
+# boundaries of that fast path against the general one.
+
+boundaries = []
+for b in (0, 1, 63, 64, 126, 127, 128):
+    for d in (-1, 1):
+        boundaries.append((1 << b) + d)
+        boundaries.append(-(1 << b) + d)
+values = sorted(set(boundaries + [0L, 1L, -1L, 3L, -7L, 1000003L, 2**64 // 3, -(2**127 // 5)]))
+
+for a in values:
+    a = long(a)
+    print a, -a, abs(a), ~a, hash(a), bool(a)
+    for b in values:
+        print a + b, a - b, a * b, a & b, a | b, a ^ b, a == b, a < b
+        if b:
+            print a // b, a % b, a / b, divmod(a, b)
+        if 0 <= b < 300:
+            print a << b, a >> b
+
+# Mixed with ints, including results that don't fit in an int anymore.
+import sys
+m = sys.maxint
+for a in (m, -m - 1, m // 2, 12345):
+    for b in (m, -m - 1, 7, -7):
+        print long(a) + b, long(a) - b, long(a) * b, long(a) // b, long(a) % b, long(a) & b, long(a) | b
+        print a + b, a - b, a * b
+
+# The typical 64-bit hash loop: the intermediates overflow an int.
+h = 0xcbf29ce484222325
+for c in "the quick brown fox":
+    h = ((h ^ ord(c)) * 0x100000001b3) & 0xffffffffffffffff
+print h, type(h)
+
+# Small longs must hash like equal ints and work as dict keys.
+d = {}
+for i in range(-5, 5):
+    d[i] = i
+for i in range(-5, 5):
+    print d[long(i)], long(i) == i, hash(long(i)) == hash(i)
+print d.get(2**64 - 2**64 + 3)
+print (1 << 64) - 1 == 18446744073709551615L, 0L == -0L, int(2L**62)
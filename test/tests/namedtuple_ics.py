@@ -0,0 +1,72 @@
+# namedtuple fields are properties wrapping operator.itemgetter; the getattr IC reads them straight out of the
+# tuple when indexing would go to tuple.__getitem__.
+
+from collections import namedtuple
+import operator
+
+P = namedtuple("P", "x y z")
+
+class Q(P):
+    @property
+    def total(self):
+        return self.x + self.y + self.z
+
+def f(p):
+    return p.x, p.y, p.z
+
+t = 0
+for i in xrange(1000):
+    p = P(i, 2, 3)
+    x, y, z = f(p)
+    t += x + y + z
+print t
+
+q = Q(1, 2, 3)
+for i in xrange(100):
+    r = f(q), q.total
+print r
+
+# Tuples of the wrong size, made by going around the namedtuple constructor:
+short = tuple.__new__(P, (1,))
+for i in xrange(3):
+    try:
+        print f(short)
+    except IndexError as e:
+        print "IndexError", e
+longer = tuple.__new__(P, (1, 2, 3, 4))
+print f(longer), len(longer)
+
+# Subclasses that change indexing:
+class R(P):
+    def __getitem__(self, idx):
+        return "R%d" % idx
+for i in xrange(3):
+    print f(R(1, 2, 3))
+
+class S(P):
+    pass
+s = S(4, 5, 6)
+for i in xrange(5):
+    print f(s)
+    if i == 2:
+        S.__getitem__ = lambda self, idx: "S%d" % idx
+
+# Other itemgetters:
+class T(tuple):
+    first = property(operator.itemgetter(0))
+    last = property(operator.itemgetter(-1))
+    both = property(operator.itemgetter(0, 1))
+    key = property(operator.itemgetter("k"))
+for i in xrange(3):
+    t = T((1, 2, 3))
+    print t.first, t.last, t.both
+    try:
+        t.key
+    except TypeError as e:
+        print "TypeError", e
+
+# The itemgetter property on a non-tuple:
+class L(list):
+    x = P.x
+for i in xrange(3):
+    print L([7, 8]).x
@@ -0,0 +1,126 @@
+# statcheck: noninit_count('slowpath_getattr') <= 100
+# statcheck: noninit_count('slowpath_callattr') <= 100
+# statcheck: noninit_count('slowpath_setattr') <= 250
+
+# Attribute lookups, method calls and __getattr__ hooks on old-style instances are cached in ICs,
+# including lookups that go through base classes.  Make sure the ICs notice changes to the classes.
+
+class A:
+    x = 1
+    def f(self, n):
+        return ("A.f", n)
+
+class B(A):
+    def g(self):
+        return "B.g"
+
+class C(B):
+    pass
+
+class D:
+    def f(self, n):
+        return ("D.f", n)
+
+def get_x(o):
+    return o.x
+
+def call_f(o, n):
+    return o.f(n)
+
+def set_y(o, v):
+    o.y = v
+
+objs = [A(), B(), C()]
+for i in xrange(1000):
+    for o in objs:
+        get_x(o)
+        call_f(o, i)
+        set_y(o, i)
+for o in objs:
+    print get_x(o), call_f(o, 1), o.y
+
+# Changing a base class after the ICs have been filled:
+A.x = 2
+print [get_x(o) for o in objs]
+B.x = 3
+print [get_x(o) for o in objs]
+del B.x
+print [get_x(o) for o in objs]
+
+def new_f(self, n):
+    return ("new_f", n)
+A.f = new_f
+print [call_f(o, 2) for o in objs]
+
+# Attributes that aren't functions, and functions stored on the instance:
+A.f = staticmethod(lambda n: ("static", n))
+print [call_f(o, 3) for o in objs]
+A.f = len
+print [call_f(o, [1, 2]) for o in objs]
+A.f = new_f
+c = C()
+c.f = lambda n: ("inst", n)
+for i in xrange(100):
+    r = call_f(c, 4)
+print r, call_f(C(), 4)
+
+# Changing __bases__:
+C.__bases__ = (D,)
+print call_f(C(), 5)
+try:
+    get_x(C())
+except AttributeError as e:
+    print e
+C.__bases__ = (B,)
+print call_f(C(), 6), get_x(C())
+
+# Bound methods obtained through getattr are still instancemethods:
+m = C().f
+print type(m).__name__, m.im_class.__name__, m(7)
+
+# __getattr__ hooks:
+class G:
+    def __getattr__(self, name):
+        if name == "missing":
+            raise AttributeError(name)
+        return "hook:" + name
+
+class H(G):
+    real = "real"
+
+def get_attr(o):
+    return o.attr
+
+def get_missing(o):
+    return getattr(o, "missing", "default")
+
+for i in xrange(1000):
+    for o in (G(), H()):
+        get_attr(o)
+        get_missing(o)
+        o.real2 = 1
+print get_attr(G()), get_attr(H()), get_missing(G()), get_missing(H()), H().real
+
+# (CPython caches __getattr__ and __setattr__ when the class is created, so only change them on the
+# class that defines them.)
+def other_hook(self, name):
+    return "other hook"
+G.__getattr__ = other_hook
+print get_attr(G())
+del G.__getattr__
+try:
+    get_attr(G())
+except AttributeError as e:
+    print e
+
+# __setattr__ defined on a base class:
+class S:
+    def __setattr__(self, name, val):
+        self.__dict__[name] = ("set", val)
+class T(S):
+    pass
+for i in xrange(100):
+    t = T()
+    set_y(t, i)
+    set_y(A(), i)
+print t.y
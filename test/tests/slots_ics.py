@@ -0,0 +1,90 @@
+# Attributes backed by __slots__ get read and written directly by the getattr/setattr ICs.
+
+class P(object):
+    __slots__ = ("x", "y")
+
+    def __init__(self, x, y):
+        self.x = x
+        self.y = y
+
+class Q(P):
+    __slots__ = ("z",)
+
+class R(P):
+    pass
+
+def move(p, n):
+    for i in xrange(n):
+        p.x = p.x + 1
+        p.y = p.x * 2
+    return p.x, p.y
+
+for cls in (P, Q, R):
+    print cls.__name__, move(cls(0, 0), 1000)
+
+# Storing different kinds of objects, and replacing them (so the old values get freed):
+class Tracked(object):
+    live = 0
+    def __init__(self):
+        Tracked.live += 1
+    def __del__(self):
+        Tracked.live -= 1
+
+p = P(None, None)
+for i in xrange(100):
+    p.x = Tracked()
+    p.y = i
+print Tracked.live, p.y
+p.x = None
+print Tracked.live
+
+# Unset and deleted slots:
+def getx(o):
+    try:
+        return o.x
+    except AttributeError as e:
+        return "AttributeError: %s" % e
+q = Q.__new__(Q)
+for i in xrange(5):
+    print getx(q),
+    if i == 1:
+        q.x = "set"
+    if i == 3:
+        del q.x
+print
+
+# Slots in subclasses at different offsets, going through the same IC:
+class S(object):
+    __slots__ = ("a", "x")
+objs = [P(1, 2), Q(3, 4), S(), R(5, 6)]
+objs[2].x = "S.x"
+for i in xrange(20):
+    for o in objs:
+        o.x = (type(o).__name__, i)
+print [o.x for o in objs]
+
+# A member descriptor used on the wrong class:
+class Wrong(object):
+    x = P.x
+for i in xrange(3):
+    w = Wrong()
+    try:
+        w.x = 1
+    except TypeError as e:
+        print "TypeError", e
+    try:
+        print w.x
+    except TypeError as e:
+        print "TypeError", e
+
+# Shadowing the slot with a class attribute or property afterwards:
+class T(object):
+    __slots__ = ("v",)
+t = T()
+def setv(t, i):
+    t.v = i
+    return t.v
+for i in xrange(5):
+    if i == 3:
+        T.v = property(lambda self: "prop", lambda self, val: None)
+    print setv(t, i)
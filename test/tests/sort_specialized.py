@@ -0,0 +1,63 @@
+# list.sort picks an unboxed comparison when all the keys are exact ints, floats or strs;
+# make sure those give the same (stable) results as the generic path.
+
+import random
+random.seed(12345)
+
+class Wrapper(object):
+    def __init__(self, v):
+        self.v = v
+    def __lt__(self, rhs):
+        return self.v < rhs.v
+
+def check(l, **kw):
+    generic = [Wrapper(x) for x in l]
+    generic.sort(key=(lambda w: kw['key'](w.v)) if 'key' in kw else None, reverse=kw.get('reverse', False))
+    fast = list(l)
+    fast.sort(**kw)
+    assert [w.v for w in generic] == fast, (l, kw)
+    assert [id(w.v) for w in generic] == [id(x) for x in fast]
+
+for n in [0, 1, 2, 10, 64, 65, 300]:
+    for gen in [lambda: random.randint(-50, 50), lambda: random.random(), lambda: str(random.randint(0, 100)),
+                lambda: random.choice([1, 1.5, "a", 2L])]:
+        l = [gen() for _ in xrange(n)]
+        check(l)
+        check(l, reverse=True)
+        check(l, key=lambda x: str(x)[:1])
+        check(l, key=lambda x: str(x)[:1], reverse=True)
+        check(sorted(l))
+        check(sorted(l, reverse=True))
+print "ok"
+
+nan = float('nan')
+l = [3.0, nan, 1.0, 2.0, nan, 0.5]
+l.sort()
+print l
+
+print sorted(["b", "a\0", "a", "", "ab"])
+print sorted([-1, 2, -3, 0, 4, 1 << 40])
+print sorted(range(10), key=lambda x: x % 3)
+print sorted(range(10), cmp=lambda x, y: cmp(y, x), key=lambda x: x % 3)
+
+class E(Exception):
+    pass
+def bad_key(x):
+    if x == 150:
+        raise E()
+    return x
+l = range(300)
+try:
+    l.sort(key=bad_key)
+except E:
+    print "caught"
+print l == range(300)
+
+l = range(300)
+def mutating_key(x):
+    l.append(x)
+    return x
+try:
+    l.sort(key=mutating_key)
+except ValueError as e:
+    print e
@@ -0,0 +1,102 @@
+# Repeated `s += x` / `s = s + x` on a local may append to the string in place;
+# make sure that can't be observed.
+
+def build(n):
+    s = ""
+    for i in range(n):
+        s += str(i % 10)
+    return s
+
+def build2(n):
+    s = "x"
+    for i in range(n):
+        s = s + "ab"
+    return s
+
+for i in xrange(3):
+    print len(build(5000)), build(30)
+    print len(build2(5000)), build2(5)[:11]
+
+def aliases():
+    s = "abc" * 3
+    t = s
+    s += "d"
+    print s, t
+
+    s = "abc" * 3
+    l = [s]
+    s += "d"
+    print s, l
+
+    s = "abc" * 3
+    s += s
+    print s
+aliases()
+
+def hashes():
+    # The cached hash of the old value must not be reused for the new one.
+    s = "key" * 2
+    d = {s: 1}
+    for i in range(5):
+        s += "x"
+        d[s] = i
+        print hash(s) == hash("keykey" + "x" * (i + 1)), len(d)
+    print sorted(d.items())
+hashes()
+
+def interned():
+    s = intern("interned_" + "string")
+    for i in range(3):
+        s += "!"
+    print s, intern("interned_string")
+interned()
+
+def types():
+    s = "a"
+    s += u"b"
+    print repr(s)
+    s = "a" * 2
+    s += bytearray("b")
+    print repr(s)
+
+    class S(str):
+        def __radd__(self, other):
+            return "radd"
+    s = "a" * 2
+    s += S("b")
+    print s
+
+    s = "a" * 2
+    try:
+        s += 1
+    except TypeError as e:
+        print e
+    print s
+types()
+
+def in_try():
+    s = ""
+    for i in range(100):
+        try:
+            s += chr(ord('a') + i % 26)
+        except Exception:
+            pass
+    print s
+in_try()
+
+def gen():
+    s = ""
+    for i in range(5):
+        s += str(i)
+        yield s
+print list(gen())
+
+def mixed(x, y, n):
+    # The same site sees strings and other types.
+    for i in range(n):
+        x += y
+        x = x + y
+    return x
+for i in range(200):
+    r = (mixed("s" * 2, "t", 3), mixed([1], [2], 2), mixed(1, 2, 2), mixed(u"u", "v", 1), mixed("w" * 2, u"x", 1))
+print r
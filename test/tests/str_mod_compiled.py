@@ -0,0 +1,83 @@
+# Constant (interned) format strings used with str % get compiled and cached; each
+# format below is used several times so that later uses run the cached version.
+# Short formats without %(key) directives skip the cache, so most of these have a
+# longer variant too.
+
+log = []
+
+class C(object):
+    def __init__(self, v):
+        self.v = v
+    def __str__(self):
+        log.append(("str", self.v))
+        return str(self.v)
+    def __repr__(self):
+        log.append(("repr", self.v))
+        return "C(%r)" % (self.v,)
+
+class U(object):
+    def __str__(self):
+        log.append("U")
+        return u"\xe9"
+
+class M(object):
+    def __getitem__(self, k):
+        log.append(("getitem", k))
+        return {"a": 1, "b": "bee", "x(y)": 2.5}[k]
+
+def f(fmt, args):
+    del log[:]
+    try:
+        r = fmt % args
+        print repr(r), type(r).__name__, log
+    except Exception as e:
+        print type(e).__name__, e, log
+
+for i in range(3):
+    f("plain", ())
+    f("", ())
+    f("%s", "x" * 300)
+    f("[%s] %s: request %d took %.3fms", ("INFO", "srv", 12345, 3.14159))
+    f("%5s|%-5s|%05d|%+d|% d|%#x|%#o|%.2f|%10.3e|%c|%c", ("a", "b", -42, 7, 7, 255, 8, 2.5, 12345.678, 65, "z"))
+    f("%ls %hd %Lf", ("l", 3, 1.5))
+    f("100%% of %s", "it")
+    f("%5%|%-5%|", ())
+    f("%s %r %s", (C(1), C("two"), C(3)))
+    f("first %s, then %r, last %s", (C(1), C("two"), C(3)))
+    f("%s and %s", (1,))
+    f("not enough arguments: %s and %s", (1,))
+    f("too many arguments: %s", (1, 2))
+    f("%s", (1, 2))
+    f("%d", "not a number")
+    f("%(a)s %(b)s %(x(y))s", M())
+    f("%(a)s %(b)s", {"a": "A", "b": u"\xfc"})
+    f("%(a)d %%", {"a": 5})
+    f("%(a)s", (1,))
+    f("%(a)s %s", {"a": 1})
+    f("%s %s %s", (C("before"), U(), C("after")))
+    f("before: %s, unicode: %s, after: %s", (C("before"), U(), C("after")))
+    f("%s %s", (u"uni", C("x")))
+    f("%-4c|", (u"\xe9",))
+    f("%s", 2 ** 100)
+    f("%x %o %d", (2 ** 70, -2 ** 65, 10 ** 20))
+    # These don't get compiled, but have to behave the same way every time too.
+    f("%*d|%.*f", (5, 42, 2, 3.14159))
+    f("%s %", (C("incomplete"),))
+    f("%s %y", (C("unsupported"), 1))
+    f("%(a", {"a": 1})
+
+# Formatting an argument can use lots of other format strings, enough to cycle
+# through the whole cache, while the outer format is still being used.
+many = [intern("format string number " + str(i) + " is %s, repeated %d times") for i in range(1000)]
+
+class Busy(object):
+    def __str__(self):
+        n = 0
+        for i in range(3):
+            for fmt in many:
+                n += len(fmt % ("busy", i))
+        return "busy(%d)" % n
+
+for i in range(3):
+    f("a long enough literal part, %s, and %s", (Busy(), C(i)))
+    f("the mapping version of it: %(a)s, %(b)s", {"a": Busy(), "b": i})
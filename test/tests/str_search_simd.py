@@ -0,0 +1,49 @@
+# Exercise the vectorized str/unicode search kernels around their block boundaries,
+# checking them against naive implementations.
+
+def naive_find(s, p):
+    for i in xrange(len(s) - len(p) + 1):
+        if s[i:i + len(p)] == p:
+            return i
+    return -1
+
+def naive_rfind(s, p):
+    for i in xrange(len(s) - len(p), -1, -1):
+        if s[i:i + len(p)] == p:
+            return i
+    return -1
+
+def naive_count(s, p):
+    n = i = 0
+    while i <= len(s) - len(p):
+        if s[i:i + len(p)] == p:
+            n += 1
+            i += len(p)
+        else:
+            i += 1
+    return n
+
+failures = 0
+for n in [0, 1, 15, 16, 17, 31, 32, 33, 47, 100, 4100]:
+    for i in xrange(3):
+        s = "".join("ab \t\n\x00\xff"[(j * 7 + i * 3 + j // 5) % 7] for j in xrange(n))
+        for p in ["a", "b", "\xff", "ab", "ba", "a b", "\x00\xffa", "zz", "b\t\n\x00\xffab"]:
+            for t, tp in [(s, p), (s.decode("latin-1"), p.decode("latin-1"))]:
+                if (t.find(tp) != naive_find(t, tp) or t.rfind(tp) != naive_rfind(t, tp)
+                        or t.count(tp) != naive_count(t, tp) or (tp in t) != (naive_find(t, tp) != -1)):
+                    print "mismatch", repr(t), repr(tp)
+                    failures += 1
+        if s.split() != [w for w in s.replace("\t", " ").replace("\n", " ").split(" ") if w]:
+            print "split mismatch", repr(s)
+            failures += 1
+print "failures:", failures
+
+s = "hello world! " * 10
+print s.count("!"), s.count("o w"), s.find("d!"), s.rfind("he"), s.index("world")
+print s.replace("o", "0", 3)
+print s.replace("world", "there")[:40]
+print s.partition("d! h"), s.rpartition("lo")
+print s.split(" w", 3)
+print " \t a  b\x0bc\x0cd\re\n  ".split(), "a  b c ".split(None, 1)
+u = s.decode("ascii")
+print u.count(u"!"), u.find(u"!"), u.rfind(u"!"), u.split(u"!")[:3]
@@ -0,0 +1,86 @@
+# statcheck: noninit_count('slowpath_callattr') <= 200
+# statcheck: noninit_count('slowpath_getattr') <= 200
+
+# super() attribute lookups and method calls get rewritten; make sure the ICs notice when the classes change.
+
+class A(object):
+    x = "A.x"
+
+    def f(self, n):
+        return ("A.f", n)
+
+    @classmethod
+    def cm(cls):
+        return ("A.cm", cls.__name__)
+
+    @staticmethod
+    def sm(n):
+        return ("A.sm", n)
+
+    @property
+    def p(self):
+        return ("A.p", type(self).__name__)
+
+class B(A):
+    def f(self, n):
+        return ("B.f", n, super(B, self).f(n))
+
+class C(B):
+    def f(self, n):
+        return ("C.f", n, super(C, self).f(n))
+
+    def lookups(self):
+        s = super(C, self)
+        return s.x, s.cm(), s.sm(1), s.p, s.f(2)
+
+c = C()
+for i in xrange(1000):
+    r = c.f(i)
+print r
+for i in xrange(1000):
+    r = c.lookups()
+print r
+
+# Unbound (class-mode) super:
+def g(cls):
+    return super(B, cls).f, super(B, cls).cm(), super(B, cls).x
+for i in xrange(3):
+    print g(C)[1:], g(C)[0](c, 5)
+
+# Methods that get called through the IC for different instance classes:
+class D(B):
+    pass
+for i in xrange(100):
+    for o in (c, D(), B()):
+        r = super(B, o).f(i)
+print r
+
+# Modifying classes in the mro after the IC has been created:
+def h(o):
+    return super(B, o).f(1), super(B, o).x
+for i in xrange(5):
+    print i, h(c)
+    if i == 1:
+        A.f = lambda self, n: ("new A.f", n)
+    if i == 2:
+        A.x = "new A.x"
+    if i == 3:
+        class Mixin(object):
+            def f(self, n):
+                return ("Mixin.f", n)
+        B.__bases__ = (Mixin, A)
+
+# Attributes that aren't found on the classes fall back to the super object itself:
+for i in xrange(3):
+    s = super(C, c)
+    print s.__thisclass__.__name__, s.__self_class__.__name__, s.__self__ is c
+    try:
+        s.nonexistent
+    except AttributeError as e:
+        print e
+
+# Instances that override the method in their __dict__ don't affect super:
+c2 = C()
+c2.f = lambda n: "instance f"
+for i in xrange(3):
+    print super(B, c2).f(i), c2.f(i)
@@ -0,0 +1,58 @@
+# Tuples cache their hash when all of their elements hash by value; make sure
+# that tuples containing objects whose hash can change are still rehashed.
+
+class H(object):
+    h = 1
+    def __hash__(self):
+        return H.h
+
+keys = [(1, "a", 2.5), ("x", (1, 2), None), (True, 10 ** 30, u"u"), ((("deep",),),)]
+for k in keys:
+    print hash(k) == hash(k) == hash(tuple(list(k)))
+
+d = {}
+for i in range(100):
+    d[("k", i, str(i))] = i
+total = 0
+for j in range(3):
+    for i in range(100):
+        total += d[("k", i, str(i))]
+print total, ("k", 5, "5") in d, ("k", 5, 5) in d
+
+h = H()
+for t in [(1, h), ("a", (2, h)), (h,)]:
+    H.h = 1
+    a = hash(t)
+    H.h = 2
+    b = hash(t)
+    print a != b, hash(t) == b
+
+s = set()
+t = (H(), "x")
+H.h = 5
+s.add(t)
+H.h = 6
+print t in s
+H.h = 5
+print t in s
+
+try:
+    hash((1, [2]))
+except TypeError as e:
+    print e
+
+# Some iterators refill their result tuple in place when nobody else holds a reference to it:
+import itertools
+print map(hash, itertools.izip([1, 2], [3, 4])) == [hash((1, 3)), hash((2, 4))]
+s = set([(2, 4)])
+print filter(s.__contains__, itertools.izip([1, 2, 3], [3, 4, 5]))
+print filter(s.__contains__, itertools.izip_longest([1, 2, 3], [3, 4]))
+s = set([(1, 2), (0, 1, 2)])
+print filter(s.__contains__, itertools.product(range(3), repeat=2))
+print filter(s.__contains__, itertools.combinations(range(3), 2))
+print filter(s.__contains__, itertools.combinations_with_replacement(range(3), 2))
+print filter(s.__contains__, itertools.permutations(range(3)))
+print filter(s.__contains__, itertools.permutations(range(3), 2))
+s = set([("b", 2)])
+print filter(s.__contains__, sorted({"a": 1, "b": 2, "c": 3}.iteritems()))
+print filter(s.__contains__, {"a": 1, "b": 2, "c": 3}.iteritems())
@@ -0,0 +1,55 @@
+# ASCII-only text can be shared between str and unicode when converting with the
+# ascii, latin-1 and utf-8 codecs; make sure the results are the same as with the
+# generic codec paths.
+
+class StrSub(str):
+    pass
+
+class UniSub(unicode):
+    pass
+
+samples = ["", "a", "ab", "hello world", "x" * 100, "tab\there\n", "\x00\x7f" * 9,
+           "caf\xc3\xa9", "\xff\xfe", "abcdefg\x80", "\xe9t\xe9"]
+
+for s in samples:
+    for enc in ("ascii", "utf-8", "UTF-8", "utf8", "latin-1", "latin1", None):
+        for errors in (None, "strict", "replace", "ignore"):
+            try:
+                if enc is None:
+                    u = s.decode()
+                elif errors is None:
+                    u = s.decode(enc)
+                else:
+                    u = s.decode(enc, errors)
+                print repr(s), enc, errors, repr(u), type(u).__name__,
+            except UnicodeDecodeError as e:
+                print repr(s), enc, errors, "UnicodeDecodeError", e.start, e.end
+                continue
+            for enc2 in ("ascii", "utf-8", "latin-1"):
+                try:
+                    b = u.encode(enc2)
+                    print repr(b), type(b).__name__, b == s,
+                except UnicodeEncodeError as e:
+                    print "UnicodeEncodeError", e.start,
+            print repr(unicode(s, "latin-1")), max(s or "\0") < "\x80" and hash(u) == hash(s)
+
+# The same unicode object encoded repeatedly, and after str() computed its default encoding.
+u = u"shared text"
+print str(u), u.encode("utf-8"), u.encode("ascii"), u.encode("latin-1"), u.encode("utf-8", "strict")
+u = u"\u20ac uro"
+try:
+    str(u)
+except UnicodeEncodeError as e:
+    print "UnicodeEncodeError", e.start
+print repr(u.encode("utf-8")), repr(u.encode("utf-8")), repr(u.encode("ascii", "replace"))
+
+# Subclasses on either side.
+print repr(StrSub("abc").decode("ascii")), repr(unicode(StrSub("abc"), "utf-8"))
+v = UniSub(u"abc")
+print repr(v.encode("utf-8")), type(v.encode("ascii")).__name__, repr(str(v)), repr(v.encode("latin-1"))
+
+# Strings built up from pieces, and buffers.
+parts = [("part%d" % i).decode("utf-8") for i in range(10)]
+joined = u",".join(parts)
+print repr(joined.encode("utf-8")), repr(joined.split(u",")[3].encode("ascii"))
+print repr(unicode(buffer("buffered"), "ascii")), repr(unicode("x" * 3))
@@ -0,0 +1,51 @@
+# The ascii, latin-1 and utf-8 codecs handle runs of ASCII (or latin-1) characters in bulk;
+# check that results and error positions don't depend on where the non-ASCII characters
+# fall relative to those blocks.
+
+def show(f):
+    try:
+        r = f()
+        return "%d %r" % (len(r), r[-6:])
+    except (UnicodeDecodeError, UnicodeEncodeError) as e:
+        return "%s %d %d %s" % (type(e).__name__, e.start, e.end, e.reason)
+
+fillers = ["abcdefghijklmnopqrstuvwxyz0123456789", "\x00\x01\x7f" * 20]
+specials = ["\xc3\xa9", "\xe2\x82\xac", "\x80", "\xff", "\xc3", "\xe2\x82",
+            "\xed\xa0\x80", "\xe0\x80\x80", "\xf4\x90\x80\x80", "\xc3\xa9\xc3\xa9"]
+
+for filler in fillers:
+    for special in specials:
+        for pos in (0, 1, 15, 16, 17, 32, 47):
+            for tail in (0, 1, 16):
+                s = filler[:pos].ljust(pos, "x") + special + ("y" * tail)
+                for enc in ("ascii", "utf-8", "latin-1"):
+                    print enc, pos, tail, repr(special),
+                    for errors in ("strict", "replace", "ignore"):
+                        print "|", show(lambda: s.decode(enc, errors)),
+                    print
+
+for n in (0, 1, 15, 16, 17, 31, 32, 33, 64, 100):
+    s = "".join(chr(32 + i % 95) for i in range(n))
+    u = s.decode("ascii")
+    assert u == s.decode("utf-8") == s.decode("latin-1") == unicode(s)
+    assert u.encode("ascii") == u.encode("utf-8") == u.encode("latin-1") == s
+
+for c in (u"\x80", u"\xe9", u"\xff", u"\u0100", u"\u20ac", u"\ud800"):
+    for pos in (0, 1, 15, 16, 17, 32, 33):
+        for tail in (0, 3, 16):
+            u = u"a" * pos + c + u"b" * tail + c
+            for enc in ("ascii", "utf-8", "latin-1"):
+                print enc, pos, tail, repr(c),
+                for errors in ("strict", "replace", "ignore", "xmlcharrefreplace"):
+                    print "|", show(lambda: u.encode(enc, errors)),
+                print
+
+# Latin-1 round trip of every byte value at every alignment
+allbytes = "".join(chr(i) for i in range(256))
+for i in range(20):
+    s = allbytes[i:] + allbytes[:i]
+    u = s.decode("latin-1")
+    assert [ord(c) for c in u] == [ord(c) for c in s]
+    assert u.encode("latin-1") == s
+    assert u.encode("utf-8").decode("utf-8") == u
+print "done"
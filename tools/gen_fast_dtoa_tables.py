@@ -0,0 +1,88 @@
+# Generates from_cpython/Python/fast_dtoa_tables.h, the power-of-ten tables used by
+# from_cpython/Python/fast_dtoa.c.
+#
+# Usage: python tools/gen_fast_dtoa_tables.py > from_cpython/Python/fast_dtoa_tables.h
+
+# Grisu cached powers: 10**k for k = -348, -340, ..., 340, as a 64-bit significand
+# (rounded to nearest) and a binary exponent.
+GRISU_MIN_EXP10 = -348
+GRISU_EXP10_STEP = 8
+GRISU_NUM_POWERS = 87
+
+# Eisel-Lemire powers: 10**k for every k in [-342, 308], as the 128 most significant
+# bits of its binary expansion, rounded down.
+LEMIRE_MIN_EXP10 = -342
+LEMIRE_MAX_EXP10 = 308
+
+
+def normalized(num, den, bits):
+    """Returns (m, e) with 2**(bits-1) <= m < 2**bits and m * 2**e ~= num / den,
+    m being rounded down."""
+    e = num.bit_length() - den.bit_length() - bits
+    while True:
+        if e >= 0:
+            m = num // (den << e)
+        else:
+            m = (num << -e) // den
+        if m >= 1 << bits:
+            e += 1
+        elif m < 1 << (bits - 1):
+            e -= 1
+        else:
+            return m, e
+
+
+def grisu_power(k):
+    num, den = (10 ** k, 1) if k >= 0 else (1, 10 ** -k)
+    m, e = normalized(num, den, 64)
+    # round to nearest
+    if e >= 0:
+        rem2 = 2 * (num - ((m * den) << e))
+        half = den << e
+    else:
+        rem2 = 2 * ((num << -e) - m * den)
+        half = den
+    if rem2 >= half:
+        m += 1
+        if m == 1 << 64:
+            m >>= 1
+            e += 1
+    return m, e
+
+
+def lemire_power(k):
+    num, den = (10 ** k, 1) if k >= 0 else (1, 10 ** -k)
+    m, e = normalized(num, den, 128)
+    return m >> 64, m & ((1 << 64) - 1)
+
+
+def main():
+    print("// Generated by tools/gen_fast_dtoa_tables.py, do not edit.")
+    print("")
+    print("#define GRISU_MIN_EXP10 (%d)" % GRISU_MIN_EXP10)
+    print("#define GRISU_EXP10_STEP %d" % GRISU_EXP10_STEP)
+    print("#define GRISU_NUM_POWERS %d" % GRISU_NUM_POWERS)
+    print("")
+    print("static const struct {")
+    print("    uint64_t f;")
+    print("    int16_t e;")
+    print("    int16_t k;")
+    print("} grisu_powers[GRISU_NUM_POWERS] = {")
+    for i in range(GRISU_NUM_POWERS):
+        k = GRISU_MIN_EXP10 + i * GRISU_EXP10_STEP
+        m, e = grisu_power(k)
+        print("    { 0x%016xULL, %d, %d }," % (m, e, k))
+    print("};")
+    print("")
+    print("#define LEMIRE_MIN_EXP10 (%d)" % LEMIRE_MIN_EXP10)
+    print("#define LEMIRE_MAX_EXP10 %d" % LEMIRE_MAX_EXP10)
+    print("")
+    print("static const uint64_t lemire_powers[LEMIRE_MAX_EXP10 - LEMIRE_MIN_EXP10 + 1][2] = {")
+    for k in range(LEMIRE_MIN_EXP10, LEMIRE_MAX_EXP10 + 1):
+        hi, lo = lemire_power(k)
+        print("    { 0x%016xULL, 0x%016xULL }, // 1e%d" % (hi, lo, k))
+    print("};")
+
+
+if __name__ == "__main__":
+    main()